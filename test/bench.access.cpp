@@ -0,0 +1,255 @@
+#include "FortranArray"
+#include "bench.h"
+#include <memory>
+using namespace fa;
+
+// per-element cost of allocatable::operator() and c() versus a raw pointer
+// loop, for 1 to 7 dimensions holding about the same number of elements, and
+// of the static dimension and tensor and the mixed_allocatable
+
+namespace {
+constexpr int ntry = 10;
+constexpr long n1 = 1 << 20;
+
+double raw(const double* p, long n)
+{
+   double s = 0;
+   for (long i = 0; i < n; ++i)
+      s += p[i];
+   return s;
+}
+
+void dim1()
+{
+   allocatable<double, 1> a;
+   a.allocate(n1);
+   a.fill(1);
+   double s = 0;
+   bench::report("1-d raw pointer",
+          bench::ns_per_elem(n1, ntry, [&]() { s += raw(a.data(), n1); }));
+   bench::report("1-d operator()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int i = 1; i <= n1; ++i)
+                s += a(i);
+          }));
+   bench::report("1-d c()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int i = 0; i < n1; ++i)
+                s += a.c(i);
+          }));
+   bench::keep(s);
+}
+
+void dim2()
+{
+   constexpr int n = 1024;
+   allocatable<double, 1, 1> a;
+   a.allocate(n, n);
+   a.fill(1);
+   double s = 0;
+   bench::report("2-d operator()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int j = 1; j <= n; ++j)
+                for (int i = 1; i <= n; ++i)
+                   s += a(i, j);
+          }));
+   bench::report("2-d c()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int j = 0; j < n; ++j)
+                for (int i = 0; i < n; ++i)
+                   s += a.c(j, i);
+          }));
+   bench::keep(s);
+}
+
+void dim3()
+{
+   constexpr int n = 128, m = 64;
+   allocatable<double, 1, 1, 1> a;
+   a.allocate(n, n, m);
+   a.fill(1);
+   double s = 0;
+   bench::report("3-d operator()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int k = 1; k <= m; ++k)
+                for (int j = 1; j <= n; ++j)
+                   for (int i = 1; i <= n; ++i)
+                      s += a(i, j, k);
+          }));
+   allocatable<double, 1, 1, 1> b;
+   b.allocate(bounds(-1, n - 2), bounds(-1, n - 2), bounds(0, m - 1));
+   b.fill(1);
+   bench::report("3-d operator() runtime bounds",
+                 bench::ns_per_elem(n1, ntry, [&]() {
+                    for (int k = 0; k < m; ++k)
+                       for (int j = -1; j < n - 1; ++j)
+                          for (int i = -1; i < n - 1; ++i)
+                             s += b(i, j, k);
+                 }));
+   bench::report("3-d c()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int k = 0; k < m; ++k)
+                for (int j = 0; j < n; ++j)
+                   for (int i = 0; i < n; ++i)
+                      s += a.c(k, j, i);
+          }));
+   mixed_allocatable<double, n, n, dyn> x;
+   x.allocate(m);
+   x.fill(1);
+   bench::report("3-d mixed operator()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int k = 1; k <= m; ++k)
+                for (int j = 1; j <= n; ++j)
+                   for (int i = 1; i <= n; ++i)
+                      s += x(i, j, k);
+          }));
+   bench::keep(s);
+}
+
+void dim4()
+{
+   constexpr int n = 32;
+   allocatable<double, 1, 1, 1, 1> a;
+   a.allocate(n, n, n, n);
+   a.fill(1);
+   double s = 0;
+   bench::report("4-d operator()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int l = 1; l <= n; ++l)
+                for (int k = 1; k <= n; ++k)
+                   for (int j = 1; j <= n; ++j)
+                      for (int i = 1; i <= n; ++i)
+                         s += a(i, j, k, l);
+          }));
+   bench::report("4-d c()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int l = 0; l < n; ++l)
+                for (int k = 0; k < n; ++k)
+                   for (int j = 0; j < n; ++j)
+                      for (int i = 0; i < n; ++i)
+                         s += a.c(l, k, j, i);
+          }));
+   bench::keep(s);
+}
+
+void dim5()
+{
+   constexpr int n = 16;
+   allocatable<double, 1, 1, 1, 1, 1> a;
+   a.allocate(n, n, n, n, n);
+   a.fill(1);
+   double s = 0;
+   bench::report("5-d operator()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int m = 1; m <= n; ++m)
+                for (int l = 1; l <= n; ++l)
+                   for (int k = 1; k <= n; ++k)
+                      for (int j = 1; j <= n; ++j)
+                         for (int i = 1; i <= n; ++i)
+                            s += a(i, j, k, l, m);
+          }));
+   bench::report("5-d c()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int m = 0; m < n; ++m)
+                for (int l = 0; l < n; ++l)
+                   for (int k = 0; k < n; ++k)
+                      for (int j = 0; j < n; ++j)
+                         for (int i = 0; i < n; ++i)
+                            s += a.c(m, l, k, j, i);
+          }));
+   bench::keep(s);
+}
+
+void dim6()
+{
+   constexpr int n = 10;
+   constexpr long nelem = 1000000;
+   allocatable<double, 1, 1, 1, 1, 1, 1> a;
+   a.allocate(n, n, n, n, n, n);
+   a.fill(1);
+   double s = 0;
+   bench::report("6-d operator()", bench::ns_per_elem(nelem, ntry, [&]() {
+             for (int q = 1; q <= n; ++q)
+                for (int m = 1; m <= n; ++m)
+                   for (int l = 1; l <= n; ++l)
+                      for (int k = 1; k <= n; ++k)
+                         for (int j = 1; j <= n; ++j)
+                            for (int i = 1; i <= n; ++i)
+                               s += a(i, j, k, l, m, q);
+          }));
+   bench::report("6-d c()", bench::ns_per_elem(nelem, ntry, [&]() {
+             for (int q = 0; q < n; ++q)
+                for (int m = 0; m < n; ++m)
+                   for (int l = 0; l < n; ++l)
+                      for (int k = 0; k < n; ++k)
+                         for (int j = 0; j < n; ++j)
+                            for (int i = 0; i < n; ++i)
+                               s += a.c(q, m, l, k, j, i);
+          }));
+   bench::keep(s);
+}
+
+void dim7()
+{
+   constexpr int n = 8;
+   constexpr long nelem = 1 << 21;
+   allocatable<double, 1, 1, 1, 1, 1, 1, 1> a;
+   a.allocate(n, n, n, n, n, n, n);
+   a.fill(1);
+   double s = 0;
+   bench::report("7-d operator()", bench::ns_per_elem(nelem, ntry, [&]() {
+             for (int r = 1; r <= n; ++r)
+                for (int q = 1; q <= n; ++q)
+                   for (int m = 1; m <= n; ++m)
+                      for (int l = 1; l <= n; ++l)
+                         for (int k = 1; k <= n; ++k)
+                            for (int j = 1; j <= n; ++j)
+                               for (int i = 1; i <= n; ++i)
+                                  s += a(i, j, k, l, m, q, r);
+          }));
+   bench::report("7-d c()", bench::ns_per_elem(nelem, ntry, [&]() {
+             for (int r = 0; r < n; ++r)
+                for (int q = 0; q < n; ++q)
+                   for (int m = 0; m < n; ++m)
+                      for (int l = 0; l < n; ++l)
+                         for (int k = 0; k < n; ++k)
+                            for (int j = 0; j < n; ++j)
+                               for (int i = 0; i < n; ++i)
+                                  s += a.c(r, q, m, l, k, j, i);
+          }));
+   bench::keep(s);
+}
+
+void fixed3()
+{
+   constexpr int n = 128, m = 64;
+   using fd = dimension<double, n, n, m>;
+   using ct = tensor<double, m, n, n>;
+   std::unique_ptr<fd> pd(new fd);
+   std::unique_ptr<ct> pt(new ct);
+   const fd& d = *pd;
+   const ct& t = *pt;
+   pd->fill(1);
+   pt->fill(1);
+   double s = 0;
+   bench::report("3-d dimension operator()",
+                 bench::ns_per_elem(n1, ntry, [&]() {
+                    for (int k = 1; k <= m; ++k)
+                       for (int j = 1; j <= n; ++j)
+                          for (int i = 1; i <= n; ++i)
+                             s += d(i, j, k);
+                 }));
+   bench::report("3-d tensor c()", bench::ns_per_elem(n1, ntry, [&]() {
+             for (int k = 0; k < m; ++k)
+                for (int j = 0; j < n; ++j)
+                   for (int i = 0; i < n; ++i)
+                      s += t.c(k, j, i);
+          }));
+   bench::keep(s);
+}
+}
+
+int main()
+{
+#ifdef FA_BOUNDS_CHECK
+   std::printf("with FA_BOUNDS_CHECK\n");
+#endif
+   dim1();
+   dim2();
+   dim3();
+   dim4();
+   dim5();
+   dim6();
+   dim7();
+   fixed3();
+   return 0;
+}
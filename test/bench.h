@@ -0,0 +1,57 @@
+#pragma once
+
+
+#include <chrono>
+#include <cstdio>
+
+
+namespace bench {
+/**
+ * @brief keeps the compiler from optimizing the benchmarked result away
+ */
+template <class T>
+void keep(const T& t)
+{
+   asm volatile("" : : "g"(&t) : "memory");
+}
+
+/**
+ * @brief returns the best wall time in ns per element out of ntry runs
+ */
+template <class F>
+double ns_per_elem(long nelem, int ntry, F f)
+{
+   using clock = std::chrono::steady_clock;
+   double best = 1.0e300;
+   for (int t = 0; t < ntry; ++t) {
+      auto t0 = clock::now();
+      f();
+      auto t1 = clock::now();
+      double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+      if (ns < best)
+         best = ns;
+   }
+   return best / nelem;
+}
+
+inline void report(const char* name, double ns)
+{
+   std::printf("%-40s %10.3f ns/elem\n", name, ns);
+}
+
+/**
+ * @brief also reports the bandwidth, given the bytes moved per element
+ */
+inline void report(const char* name, double ns, double bytes)
+{
+   std::printf("%-40s %10.3f ns/elem %8.2f GB/s\n", name, ns, bytes / ns);
+}
+
+/**
+ * @brief also reports the arithmetic rate, given the flops per element
+ */
+inline void report_flops(const char* name, double ns, double flops)
+{
+   std::printf("%-40s %10.3f ns/elem %8.2f GFLOP/s\n", name, ns, flops / ns);
+}
+}
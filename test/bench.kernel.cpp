@@ -0,0 +1,513 @@
+#include "FortranArray"
+#include "bench.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+using namespace fa;
+
+// memory-bound kernels written against a raw pointer, dimension, tensor and
+// allocatable; the array versions are expected to match the raw pointer;
+// scratch arrays reallocated every step from the heap or an arena;
+// small blocks allocated per element on the heap or inline; batches of
+// small matrices stored per object or interleaved by batch index;
+// one field of particles stored as an array of structs or of arrays; and
+// the packing of ghost layers
+
+namespace {
+constexpr int ntry = 10;
+
+void triad()
+{
+   constexpr long n = 1 << 22;
+   constexpr double s = 3;
+   allocatable<double, 1> a, b, c;
+   a.allocate(n);
+   b.allocate(n);
+   c.allocate(n);
+   b.fill(1);
+   c.fill(2);
+   double* pa = a.data();
+   const double* pb = b.data();
+   const double* pc = c.data();
+   bench::report("triad raw pointer", bench::ns_per_elem(n, ntry, [&]() {
+                    for (long i = 0; i < n; ++i)
+                       pa[i] = pb[i] + s * pc[i];
+                    bench::keep(pa[0]);
+                 }),
+                 24);
+   bench::report("triad operator()", bench::ns_per_elem(n, ntry, [&]() {
+                    for (long i = 1; i <= n; ++i)
+                       a(i) = b(i) + s * c(i);
+                    bench::keep(a(1));
+                 }),
+                 24);
+   bench::report("triad expression", bench::ns_per_elem(n, ntry, [&]() {
+                    a = b + s * c;
+                    bench::keep(a(1));
+                 }),
+                 24);
+   bench::report("triad for_each_simd", bench::ns_per_elem(n, ntry, [&]() {
+                    for_each_simd(
+                       [](double& x, double y, double z) { x = y + s * z; },
+                       a, b, c);
+                    bench::keep(a(1));
+                 }),
+                 24);
+}
+
+constexpr int ns = 128;
+using fstatic = dimension<double, ns, ns, ns>;
+using cstatic = tensor<double, ns, ns, ns>;
+
+void stencil()
+{
+   constexpr long n = (ns - 2) * (ns - 2) * (ns - 2);
+   constexpr double c0 = 0.4, c1 = 0.1;
+   allocatable<double, 1, 1, 1> a, b;
+   a.allocate(ns, ns, ns);
+   b.allocate(ns, ns, ns);
+   a.fill(1);
+   b.zero();
+   const double* pa = a.data();
+   double* pb = b.data();
+   bench::report("7-point stencil raw pointer",
+                 bench::ns_per_elem(n, ntry, [&]() {
+                    constexpr long sj = ns, sk = ns * ns;
+                    for (long k = 1; k < ns - 1; ++k)
+                       for (long j = 1; j < ns - 1; ++j)
+                          for (long i = 1; i < ns - 1; ++i) {
+                             const long m = i + sj * j + sk * k;
+                             pb[m] = c0 * pa[m] +
+                                     c1 * (pa[m - 1] + pa[m + 1] +
+                                           pa[m - sj] + pa[m + sj] +
+                                           pa[m - sk] + pa[m + sk]);
+                          }
+                    bench::keep(pb[0]);
+                 }),
+                 16);
+   bench::report("7-point stencil allocatable",
+                 bench::ns_per_elem(n, ntry, [&]() {
+                    for (int k = 2; k < ns; ++k)
+                       for (int j = 2; j < ns; ++j)
+                          for (int i = 2; i < ns; ++i)
+                             b(i, j, k) =
+                                c0 * a(i, j, k) +
+                                c1 * (a(i - 1, j, k) + a(i + 1, j, k) +
+                                      a(i, j - 1, k) + a(i, j + 1, k) +
+                                      a(i, j, k - 1) + a(i, j, k + 1));
+                    bench::keep(b(1, 1, 1));
+                 }),
+                 16);
+
+   std::unique_ptr<fstatic> sa(new fstatic), sb(new fstatic);
+   sa->fill(1);
+   sb->zero();
+   fstatic &x = *sa, &y = *sb;
+   bench::report("7-point stencil dimension",
+                 bench::ns_per_elem(n, ntry, [&]() {
+                    for (int k = 2; k < ns; ++k)
+                       for (int j = 2; j < ns; ++j)
+                          for (int i = 2; i < ns; ++i)
+                             y(i, j, k) =
+                                c0 * x(i, j, k) +
+                                c1 * (x(i - 1, j, k) + x(i + 1, j, k) +
+                                      x(i, j - 1, k) + x(i, j + 1, k) +
+                                      x(i, j, k - 1) + x(i, j, k + 1));
+                    bench::keep(y(1, 1, 1));
+                 }),
+                 16);
+
+   std::unique_ptr<cstatic> ca(new cstatic), cb(new cstatic);
+   ca->fill(1);
+   cb->zero();
+   cstatic &u = *ca, &v = *cb;
+   bench::report("7-point stencil tensor", bench::ns_per_elem(n, ntry, [&]() {
+                    for (int k = 1; k < ns - 1; ++k)
+                       for (int j = 1; j < ns - 1; ++j)
+                          for (int i = 1; i < ns - 1; ++i)
+                             v.c(k, j, i) =
+                                c0 * u.c(k, j, i) +
+                                c1 * (u.c(k, j, i - 1) + u.c(k, j, i + 1) +
+                                      u.c(k, j - 1, i) + u.c(k, j + 1, i) +
+                                      u.c(k - 1, j, i) + u.c(k + 1, j, i));
+                    bench::keep(v.c(0, 0, 0));
+                 }),
+                 16);
+}
+
+template <index_t EDGE>
+void tiled_stencil(const char* name)
+{
+   constexpr long n = (ns - 2) * (ns - 2) * (ns - 2);
+   constexpr double c0 = 0.4, c1 = 0.1;
+   tiled_allocatable<double, EDGE, 1, 1, 1> a, b;
+   a.allocate(ns, ns, ns);
+   b.allocate(ns, ns, ns);
+   a.fill(1);
+   b.fill(0);
+   // inside a tile, a row along i is contiguous in both arrays and so are
+   // its neighbour rows along j and k; only the ends of the row look into
+   // the tiles on either side along i
+   bench::report(name, bench::ns_per_elem(n, ntry, [&]() {
+                    b.for_each_tile([&](view<double, 3> t) {
+                       const int i0 = std::max<int>(t.lbound(1), 2);
+                       const int i1 = std::min<int>(t.ubound(1), ns - 1);
+                       const int j1 = std::min<int>(t.ubound(2), ns - 1);
+                       const int k1 = std::min<int>(t.ubound(3), ns - 1);
+                       for (int k = std::max<int>(t.lbound(3), 2); k <= k1; ++k)
+                          for (int j = std::max<int>(t.lbound(2), 2); j <= j1;
+                               ++j) {
+                             double* o = &t(i0, j, k) - i0;
+                             const double* c = &a(i0, j, k) - i0;
+                             const double* jm = &a(i0, j - 1, k) - i0;
+                             const double* jp = &a(i0, j + 1, k) - i0;
+                             const double* km = &a(i0, j, k - 1) - i0;
+                             const double* kp = &a(i0, j, k + 1) - i0;
+                             const double e = a(i1 + 1, j, k);
+                             double w = a(i0 - 1, j, k);
+                             for (int i = i0; i <= i1; ++i) {
+                                const double x = i < i1 ? c[i + 1] : e;
+                                o[i] = c0 * c[i] + c1 * (w + x + jm[i] + jp[i] +
+                                                         km[i] + kp[i]);
+                                w = c[i];
+                             }
+                          }
+                    });
+                    bench::keep(b(1, 1, 1));
+                 }),
+                 16);
+}
+
+void transposed()
+{
+   constexpr long n = 2048, nn = n * n;
+   allocatable<double, 1, 1> a, b;
+   a.allocate(n, n);
+   b.allocate(n, n);
+   a.fill(1);
+   const double* pa = a.data();
+   double* pb = b.data();
+   bench::report("transpose raw pointer",
+                 bench::ns_per_elem(nn, ntry, [&]() {
+                    for (long j = 0; j < n; ++j)
+                       for (long i = 0; i < n; ++i)
+                          pb[i + n * j] = pa[j + n * i];
+                    bench::keep(pb[0]);
+                 }),
+                 16);
+   bench::report("transpose operator()", bench::ns_per_elem(nn, ntry, [&]() {
+                    for (int j = 1; j <= n; ++j)
+                       for (int i = 1; i <= n; ++i)
+                          b(i, j) = a(j, i);
+                    bench::keep(b(1, 1));
+                 }),
+                 16);
+   bench::report("transpose c()", bench::ns_per_elem(nn, ntry, [&]() {
+                    for (int j = 0; j < n; ++j)
+                       for (int i = 0; i < n; ++i)
+                          b.c(j, i) = a.c(i, j);
+                    bench::keep(b(1, 1));
+                 }),
+                 16);
+}
+
+void chained()
+{
+   constexpr long n = 128, m = 64, nnm = n * n * m;
+   allocatable<double, 1, 1, 1> a;
+   a.allocate(n, n, m);
+   a.fill(1);
+   const double* p = a.data();
+   double s = 0;
+   bench::report("[][][] raw pointer",
+                 bench::ns_per_elem(nnm, ntry, [&]() {
+                    for (long k = 0; k < m; ++k)
+                       for (long j = 0; j < n; ++j)
+                          for (long i = 0; i < n; ++i)
+                             s += p[i + n * (j + n * k)];
+                 }),
+                 8);
+   bench::report("[][][] allocatable",
+                 bench::ns_per_elem(nnm, ntry, [&]() {
+                    for (int k = 0; k < m; ++k)
+                       for (int j = 0; j < n; ++j)
+                          for (int i = 0; i < n; ++i)
+                             s += a[k][j][i];
+                 }),
+                 8);
+   bench::report("[][][] allocatable c()",
+                 bench::ns_per_elem(nnm, ntry, [&]() {
+                    for (int k = 0; k < m; ++k)
+                       for (int j = 0; j < n; ++j)
+                          for (int i = 0; i < n; ++i)
+                             s += a.c(k, j, i);
+                 }),
+                 8);
+   std::unique_ptr<cstatic> t(new cstatic);
+   t->fill(1);
+   const cstatic& u = *t;
+   bench::report("[][][] tensor", bench::ns_per_elem(ns * ns * ns, ntry, [&]() {
+                    for (int k = 0; k < ns; ++k)
+                       for (int j = 0; j < ns; ++j)
+                          for (int i = 0; i < ns; ++i)
+                             s += u[k][j][i];
+                 }),
+                 8);
+   bench::keep(s);
+}
+
+template <class ARR>
+void scratch_steps(ARR& a, int nstep, int n)
+{
+   for (int step = 0; step < nstep; ++step) {
+      a.allocate(n, n, n);
+      a.fill(step);
+      bench::keep(a(1, 1, 1));
+      a.deallocate();
+   }
+}
+
+void scratch()
+{
+   constexpr int n = 48, nstep = 100;
+   constexpr long nelem = long(n) * n * n * nstep;
+   allocatable<double, 1, 1, 1> a;
+   bench::report("scratch allocate/fill aligned",
+                 bench::ns_per_elem(nelem, ntry,
+                                    [&]() { scratch_steps(a, nstep, n); }),
+                 8);
+   arena_allocatable<double, 1, 1, 1> b;
+   bench::report("scratch allocate/fill arena",
+                 bench::ns_per_elem(nelem, ntry,
+                                    [&]() { scratch_steps(b, nstep, n); }),
+                 8);
+}
+
+template <class ARR>
+double block_steps(long m, int n)
+{
+   // a fresh n x n block per element, as for per-element jacobians
+   double s = 0;
+   for (long e = 0; e < m; ++e) {
+      ARR j;
+      j.allocate(n, n);
+      for (int c = 1; c <= n; ++c)
+         for (int r = 1; r <= n; ++r)
+            j(r, c) = e + r - c;
+      for (int k = 1; k <= n; ++k)
+         s += j(k, k);
+   }
+   return s;
+}
+
+void blocks()
+{
+   constexpr long m = 1 << 20;
+   constexpr int n = 3;
+   bench::report("3x3 blocks allocatable",
+                 bench::ns_per_elem(m, ntry, [&]() {
+                    bench::keep(block_steps<allocatable<double, 1, 1>>(m, n));
+                 }));
+   bench::report("3x3 blocks small_allocatable",
+                 bench::ns_per_elem(m, ntry, [&]() {
+                    using small_t = small_allocatable<double, 16, 1, 1>;
+                    bench::keep(block_steps<small_t>(m, n));
+                 }));
+}
+
+using mat4 = dimension<double, 4, 4>;
+using vec4 = dimension<double, 4>;
+
+void lu_solve_one(mat4& a, vec4& x)
+{
+   int piv[4];
+   for (int j = 1; j <= 4; ++j) {
+      int p = j;
+      for (int r = j + 1; r <= 4; ++r)
+         if (std::abs(a(r, j)) > std::abs(a(p, j)))
+            p = r;
+      piv[j - 1] = p;
+      for (int c = 1; c <= 4; ++c)
+         std::swap(a(j, c), a(p, c));
+      for (int r = j + 1; r <= 4; ++r) {
+         a(r, j) /= a(j, j);
+         for (int c = j + 1; c <= 4; ++c)
+            a(r, c) -= a(r, j) * a(j, c);
+      }
+   }
+   for (int j = 1; j <= 4; ++j)
+      std::swap(x(j), x(piv[j - 1]));
+   for (int i = 2; i <= 4; ++i)
+      for (int l = 1; l < i; ++l)
+         x(i) -= a(i, l) * x(l);
+   for (int i = 4; i >= 1; --i) {
+      for (int l = i + 1; l <= 4; ++l)
+         x(i) -= a(i, l) * x(l);
+      x(i) /= a(i, i);
+   }
+}
+
+void batched()
+{
+   // 4x4 matrices, one object per matrix or interleaved by batch index
+   constexpr long m = 1 << 11;
+   std::vector<mat4> a(m), b(m), c(m), lu(m);
+   std::vector<vec4> x(m), y(m);
+   batch<mat4> ba(m), bb(m), bc(m), blu(m);
+   batch<vec4> bx(m), by(m);
+   batch<dimension<int, 4>> piv(m);
+   for (long k = 0; k < m; ++k) {
+      for (int j = 1; j <= 4; ++j) {
+         for (int i = 1; i <= 4; ++i) {
+            a[k](i, j) = std::sin(k + 3.0 * i * j + j) + (i == j ? 4 : 0);
+            b[k](i, j) = std::cos(k + i - j);
+         }
+         x[k](j) = j;
+      }
+      ba.set(k + 1, a[k]);
+      bb.set(k + 1, b[k]);
+      bx.set(k + 1, x[k]);
+   }
+
+   bench::report("4x4 gemm per object", bench::ns_per_elem(m, ntry, [&]() {
+                    for (long k = 0; k < m; ++k)
+                       for (int j = 1; j <= 4; ++j)
+                          for (int i = 1; i <= 4; ++i) {
+                             double s = 0;
+                             for (int l = 1; l <= 4; ++l)
+                                s += a[k](i, l) * b[k](l, j);
+                             c[k](i, j) = s;
+                          }
+                    bench::keep(c[0]);
+                 }));
+   bench::report("4x4 gemm batched", bench::ns_per_elem(m, ntry, [&]() {
+                    batch_gemm(ba, bb, bc);
+                    bench::keep(bc(1, 1, 1));
+                 }));
+   bench::report("4x4 gemv per object", bench::ns_per_elem(m, ntry, [&]() {
+                    for (long k = 0; k < m; ++k)
+                       for (int i = 1; i <= 4; ++i) {
+                          double s = 0;
+                          for (int l = 1; l <= 4; ++l)
+                             s += a[k](i, l) * x[k](l);
+                          y[k](i) = s;
+                       }
+                    bench::keep(y[0]);
+                 }));
+   bench::report("4x4 gemv batched", bench::ns_per_elem(m, ntry, [&]() {
+                    batch_gemv(ba, bx, by);
+                    bench::keep(by(1, 1));
+                 }));
+   bench::report("4x4 lu solve per object",
+                 bench::ns_per_elem(m, ntry, [&]() {
+                    for (long k = 0; k < m; ++k) {
+                       lu[k] = a[k];
+                       y[k] = x[k];
+                       lu_solve_one(lu[k], y[k]);
+                    }
+                    bench::keep(y[0]);
+                 }));
+   bench::report("4x4 lu solve batched", bench::ns_per_elem(m, ntry, [&]() {
+                    std::copy(ba.data(), ba.data() + 16 * ba.stride(),
+                              blu.data());
+                    std::copy(bx.data(), bx.data() + 4 * bx.stride(),
+                              by.data());
+                    batch_lu(blu, piv);
+                    batch_lu_solve(blu, piv, by);
+                    bench::keep(by(1, 1));
+                 }));
+}
+
+void halo()
+{
+   // packs the 26 neighbour regions of a 64^3 block with 2 ghost layers
+   constexpr int n = 64, w = 2;
+   halo_allocatable<double, 1, 1, 1> u;
+   u.allocate(w, n, n, n);
+   u.fill(1);
+   std::vector<std::array<int, 3>> dirs;
+   long total = 0;
+   for (int k = -1; k <= 1; ++k)
+      for (int j = -1; j <= 1; ++j)
+         for (int i = -1; i <= 1; ++i)
+            if (i || j || k) {
+               dirs.push_back({{i, j, k}});
+               total += u.halo_size(dirs.back());
+            }
+   std::vector<double> buf(total);
+   bench::report("halo pack scalar loops",
+                 bench::ns_per_elem(total, ntry, [&]() {
+                    double* p = buf.data();
+                    for (const auto& d : dirs) {
+                       auto r = u.send_region(d);
+                       for (index_t c = r.lbound(3); c <= r.ubound(3); ++c)
+                          for (index_t b = r.lbound(2); b <= r.ubound(2); ++b)
+                             for (index_t a = r.lbound(1); a <= r.ubound(1);
+                                  ++a)
+                                *p++ = u(a, b, c);
+                    }
+                    bench::keep(buf[0]);
+                 }),
+                 16);
+   bench::report("halo pack", bench::ns_per_elem(total, ntry, [&]() {
+                    double* p = buf.data();
+                    for (const auto& d : dirs)
+                       p += u.pack(d, p);
+                    bench::keep(buf[0]);
+                 }),
+                 16);
+}
+
+struct particle
+{
+   double x, y, z, vx, vy, vz, m, q;
+};
+
+void particles()
+{
+   // x += dt * vx touches 2 of 8 fields, i.e. 24 useful bytes per particle
+   constexpr long n = 1 << 21;
+   constexpr double dt = 0.1;
+   allocatable<particle, 1> aos;
+   aos.allocate(n);
+   for (long i = 1; i <= n; ++i)
+      aos(i) = particle{0, 0, 0, 1, 1, 1, 1, 1};
+   bench::report("push x array of structs", bench::ns_per_elem(n, ntry, [&]() {
+                    for (long i = 1; i <= n; ++i)
+                       aos(i).x += dt * aos(i).vx;
+                    bench::keep(aos(1));
+                 }),
+                 24);
+
+   using fields = std::tuple<double, double, double, double, double, double,
+                             double, double>;
+   soa_allocatable<fields, 1> soa;
+   soa.allocate(n);
+   for (long i = 1; i <= n; ++i)
+      soa(i) = std::make_tuple(0., 0., 0., 1., 1., 1., 1., 1.);
+   bench::report("push x structure of arrays",
+                 bench::ns_per_elem(n, ntry, [&]() {
+                    for (long i = 1; i <= n; ++i)
+                       soa.get<0>(i) += dt * soa.get<3>(i);
+                    bench::keep(soa.get<0>(1));
+                 }),
+                 24);
+}
+}
+
+int main()
+{
+   triad();
+   stencil();
+   tiled_stencil<4>("7-point stencil 4x4x4 tiles");
+   tiled_stencil<8>("7-point stencil 8x8x8 tiles");
+   tiled_stencil<16>("7-point stencil 16x16x16 tiles");
+   transposed();
+   chained();
+   scratch();
+   blocks();
+   batched();
+   particles();
+   halo();
+   return 0;
+}
@@ -0,0 +1,65 @@
+#define FA_WITH_THREADS
+#include "FortranArray"
+#include "bench.h"
+#include <cstdio>
+using namespace fa;
+
+// GFLOP/s of the cache-blocked matmul, serial and on a thread_pool, against
+// the naive triple loop for square matrices of order 8 to 4096
+
+namespace {
+void square(int n, thread_pool& pool)
+{
+   const long nn = long(n) * n;
+   // 2n flops per element of c; about 2^30 flops per timed run
+   const int ntry = n >= 2048 ? 1 : n >= 512 ? 3 : 5;
+   const int reps = n >= 1024 ? 1 : int((1L << 30) / (2 * nn * n));
+   allocatable<double, 1, 1> a, b, c;
+   a.allocate(n, n);
+   b.allocate(n, n);
+   c.allocate(n, n);
+   a.fill(1);
+   b.fill(0.5);
+   char name[64];
+   if (n <= 512) {
+      std::snprintf(name, sizeof(name), "matmul %4d naive", n);
+      bench::report_flops(name, bench::ns_per_elem(nn * reps, ntry, [&]() {
+                             for (int r = 0; r < reps; ++r) {
+                                for (int j = 1; j <= n; ++j) {
+                                   for (int i = 1; i <= n; ++i)
+                                      c(i, j) = 0;
+                                   for (int p = 1; p <= n; ++p)
+                                      for (int i = 1; i <= n; ++i)
+                                         c(i, j) += a(i, p) * b(p, j);
+                                }
+                                bench::keep(c(1, 1));
+                             }
+                          }),
+                          2.0 * n);
+   }
+   std::snprintf(name, sizeof(name), "matmul %4d", n);
+   bench::report_flops(name, bench::ns_per_elem(nn * reps, ntry, [&]() {
+                          for (int r = 0; r < reps; ++r) {
+                             matmul(c, a, b);
+                             bench::keep(c(1, 1));
+                          }
+                       }),
+                       2.0 * n);
+   std::snprintf(name, sizeof(name), "matmul %4d thread_pool", n);
+   bench::report_flops(name, bench::ns_per_elem(nn * reps, ntry, [&]() {
+                          for (int r = 0; r < reps; ++r) {
+                             matmul(c, a, b, pool);
+                             bench::keep(c(1, 1));
+                          }
+                       }),
+                       2.0 * n);
+}
+}
+
+int main()
+{
+   thread_pool pool;
+   for (int n = 8; n <= 4096; n *= 2) {
+      square(n, pool);
+   }
+}
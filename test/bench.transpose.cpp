@@ -0,0 +1,85 @@
+#define FA_WITH_THREADS
+#include "FortranArray"
+#include "bench.h"
+using namespace fa;
+
+// throughput of the cache-blocked transpose, layout conversion and in-place
+// transpose against the naive nested loops
+
+namespace {
+constexpr int ntry = 5;
+
+void transpose2()
+{
+   constexpr int n = 4096;
+   constexpr long nn = long(n) * n;
+   allocatable<double, 1, 1> a, b;
+   a.allocate(n, n);
+   b.allocate(n, n);
+   a.fill(1);
+   bench::report("2-d transpose naive", bench::ns_per_elem(nn, ntry, [&]() {
+                    for (int j = 1; j <= n; ++j)
+                       for (int i = 1; i <= n; ++i)
+                          b(i, j) = a(j, i);
+                    bench::keep(b(1, 1));
+                 }),
+                 16);
+   bench::report("2-d transpose", bench::ns_per_elem(nn, ntry, [&]() {
+                    transpose(b, a);
+                    bench::keep(b(1, 1));
+                 }),
+                 16);
+   thread_pool pool;
+   bench::report("2-d transpose thread_pool",
+                 bench::ns_per_elem(nn, ntry, [&]() {
+                    transpose(b, a, pool);
+                    bench::keep(b(1, 1));
+                 }),
+                 16);
+   bench::report("2-d in-place transpose naive",
+                 bench::ns_per_elem(nn, ntry, [&]() {
+                    for (int j = 2; j <= n; ++j)
+                       for (int i = 1; i < j; ++i)
+                          std::swap(a(i, j), a(j, i));
+                    bench::keep(a(1, 1));
+                 }),
+                 16);
+   bench::report("2-d in-place transpose",
+                 bench::ns_per_elem(nn, ntry, [&]() {
+                    transpose_in_place(a);
+                    bench::keep(a(1, 1));
+                 }),
+                 16);
+}
+
+void convert3()
+{
+   constexpr int n = 256;
+   constexpr long nnn = long(n) * n * n;
+   allocatable<double, 1, 1, 1> a;
+   allocatable<double, 0, 0, 0> t;
+   a.allocate(n, n, n);
+   t.reserve(n, n, n);
+   a.fill(1);
+   bench::report("3-d 'f' to 'c' naive", bench::ns_per_elem(nnn, ntry, [&]() {
+                    for (int k = 1; k <= n; ++k)
+                       for (int j = 1; j <= n; ++j)
+                          for (int i = 1; i <= n; ++i)
+                             t.c(i - 1, j - 1, k - 1) = a(i, j, k);
+                    bench::keep(t.c(0, 0, 0));
+                 }),
+                 16);
+   bench::report("3-d 'f' to 'c'", bench::ns_per_elem(nnn, ntry, [&]() {
+                    convert_layout(t, a);
+                    bench::keep(t.c(0, 0, 0));
+                 }),
+                 16);
+}
+}
+
+int main()
+{
+   transpose2();
+   convert3();
+   return 0;
+}
@@ -1,4 +1,5 @@
 #include "FortranArray"
+#include <vector>
 #include "catch.hpp"
 using namespace fa;
 
@@ -418,3 +419,312 @@ TEST_CASE("allocatable tests dimension equals 5", "[allocatable]")
                   }
    }
 }
+
+namespace {
+struct counted
+{
+   static int alive;
+   int value;
+   counted()
+      : value(42)
+   {
+      ++alive;
+   }
+   ~counted()
+   {
+      --alive;
+   }
+};
+int counted::alive = 0;
+}
+
+TEST_CASE("allocatable storage and allocators", "[allocatable]")
+{
+   SECTION("64-byte aligned by default")
+   {
+      allocatable<char, 1> a1;
+      allocatable<double, 1, 1, 1> a3;
+      a1.allocate(3);
+      a3.allocate(3, 5, 7);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(a1.data()) % 64 == 0);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(a3.data()) % 64 == 0);
+   }
+
+   SECTION("user-provided alignment and value initialization")
+   {
+      basic_allocatable<int, aligned_allocator<int, 4096, true>, 1, 1> a;
+      a.allocate(100, 100);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(a.data()) % 4096 == 0);
+      for (int i = 0; i < a.size(); ++i) {
+         REQUIRE(a.data()[i] == 0);
+      }
+   }
+
+   SECTION("oversized requests throw instead of wrapping around")
+   {
+      aligned_allocator<double> al;
+      REQUIRE_THROWS_AS(al.allocate(std::size_t(-1) / 4), std::bad_alloc);
+   }
+
+   SECTION("std::allocator")
+   {
+      basic_allocatable<int, std::allocator<int>, 0, 0> a;
+      a.reserve(2, 3);
+      REQUIRE(a.size() == 6);
+      a.fill(7);
+      REQUIRE(a(0, 1) == 7);
+   }
+
+   SECTION("non-trivial elements are constructed and destroyed")
+   {
+      {
+         allocatable<counted, 1, 1> a;
+         a.allocate(3, 4);
+         REQUIRE(counted::alive == 12);
+         REQUIRE(a(3, 4).value == 42);
+         a.deallocate();
+         REQUIRE(counted::alive == 0);
+         a.allocate(2, 2);
+         REQUIRE(counted::alive == 4);
+      }
+      REQUIRE(counted::alive == 0);
+   }
+}
+
+namespace {
+allocatable<int, 1, 1> make_iota(int m, int n)
+{
+   allocatable<int, 1, 1> a;
+   a.allocate(m, n);
+   for (int i = 0; i < a.size(); ++i) {
+      a.data()[i] = i;
+   }
+   return a;
+}
+}
+
+TEST_CASE("allocatable move and swap", "[allocatable]")
+{
+   SECTION("move construction and assignment")
+   {
+      allocatable<int, 1, 1> a = make_iota(3, 4);
+      REQUIRE(a.allocated());
+      REQUIRE(a.size() == 12);
+      REQUIRE(a(3, 4) == 11);
+
+      const int* p = a.data();
+      allocatable<int, 1, 1> b(std::move(a));
+      REQUIRE_FALSE(a.allocated());
+      REQUIRE(a.size() == 0);
+      REQUIRE(b.data() == p);
+      REQUIRE(b(2, 3) == 7);
+
+      a = make_iota(2, 2);
+      a = std::move(b);
+      REQUIRE_FALSE(b.allocated());
+      REQUIRE(a.data() == p);
+      REQUIRE(a.size() == 12);
+      REQUIRE(a[2][1] == 7);
+   }
+
+   SECTION("swap exchanges buffers")
+   {
+      allocatable<int, 1, 1> a = make_iota(3, 4);
+      allocatable<int, 1, 1> b = make_iota(2, 5);
+      const int* pa = a.data();
+      const int* pb = b.data();
+      swap(a, b);
+      REQUIRE(a.data() == pb);
+      REQUIRE(b.data() == pa);
+      REQUIRE(a.size() == 10);
+      REQUIRE(a(2, 5) == 9);
+      REQUIRE(b(3, 4) == 11);
+      a.swap(b);
+      REQUIRE(a.data() == pa);
+      REQUIRE(a(3, 4) == 11);
+   }
+
+   SECTION("stored in std::vector")
+   {
+      std::vector<allocatable<int, 1, 1>> v;
+      for (int i = 1; i <= 8; ++i) {
+         v.push_back(make_iota(i, 2));
+      }
+      for (int i = 1; i <= 8; ++i) {
+         REQUIRE(v[i - 1].size() == 2 * i);
+         REQUIRE(v[i - 1](i, 2) == 2 * i - 1);
+      }
+   }
+}
+
+TEST_CASE("allocatable with runtime lower bounds", "[allocatable]")
+{
+   SECTION("fortran allocate(a(-1:2, 3, 5:6))")
+   {
+      allocatable<int, 1, 1, 1> ff;
+      ff.allocate(bounds(-1, 2), 3, bounds(5, 6));
+      REQUIRE(ff.size() == 24);
+      REQUIRE(ff.lbound(1) == -1);
+      REQUIRE(ff.ubound(1) == 2);
+      REQUIRE(ff.lbound(2) == 1);
+      REQUIRE(ff.ubound(2) == 3);
+      REQUIRE(ff.lbound(3) == 5);
+      REQUIRE(ff.ubound(3) == 6);
+
+      int* pf = ff.data();
+      for (int i = 0; i < ff.size(); ++i) {
+         pf[i] = i;
+      }
+
+      int count = 0;
+      for (int a = 0; a < 2; ++a)
+         for (int b = 0; b < 3; ++b)
+            for (int c = 0; c < 4; ++c) {
+               REQUIRE(count == ff(c - 1, b + 1, a + 5));
+               REQUIRE(count == ff[a][b][c]);
+               REQUIRE(count == ff.c(a, b, c));
+               ++count;
+            }
+
+      // the default lower bounds are restored after deallocation
+      ff.reallocate(4, 3, 2);
+      REQUIRE(ff.lbound(1) == 1);
+      REQUIRE(ff.lbound(3) == 1);
+      REQUIRE(&ff(1, 1, 1) == ff.data());
+   }
+
+   SECTION("c/c++ reserve with range objects")
+   {
+      allocatable<int, 0, 0> cc;
+      cc.reserve(r(10, 11), 3);
+      REQUIRE(cc.size() == 6);
+      REQUIRE(cc.lbound(1) == 0);
+      REQUIRE(cc.lbound(2) == 10);
+
+      int* pc = cc.data();
+      for (int i = 0; i < cc.size(); ++i) {
+         pc[i] = i;
+      }
+
+      int count = 0;
+      for (int a = 0; a < 2; ++a)
+         for (int b = 0; b < 3; ++b) {
+            REQUIRE(count == cc(b, a + 10));
+            REQUIRE(count == cc[a][b]);
+            ++count;
+         }
+   }
+
+   SECTION("1 dimensional")
+   {
+      allocatable<double, 1> a;
+      a.allocate(bounds(-1000000, 1000000));
+      REQUIRE(a.size() == 2000001);
+      REQUIRE(&a(-1000000) == a.data());
+      REQUIRE(&a(0) == a.data() + 1000000);
+   }
+
+   SECTION("empty bounds give zero-sized arrays")
+   {
+      allocatable<double, 1> a;
+      a.allocate(bounds(5, 2));
+      REQUIRE(a.allocated());
+      REQUIRE(a.size() == 0);
+      REQUIRE(a.ubound(1) == 4);
+      a.fill(1);
+      REQUIRE(bounds(5, 2).size() == 0);
+      REQUIRE(bounds(5, 4).size() == 0);
+      REQUIRE(bounds(5, 5).size() == 1);
+
+      allocatable<int, 1, 1> b;
+      b.allocate(3, -2);
+      REQUIRE(b.size() == 0);
+      REQUIRE(b.ubound(1) == 3);
+      REQUIRE(b.ubound(2) == 0);
+   }
+}
+
+TEST_CASE("allocatable reallocation keeping contents", "[allocatable]")
+{
+   SECTION("growing the last dimension reuses the capacity")
+   {
+      allocatable<int, 1> a;
+      a.reallocate(keep, 1);
+      a(1) = 1;
+      const int* last = a.data();
+      int moves = 0;
+      for (int n = 2; n <= 1000; ++n) {
+         a.reallocate(keep, n);
+         a(n) = n;
+         if (a.data() != last)
+            ++moves;
+         last = a.data();
+         REQUIRE(a.capacity() >= a.size());
+      }
+      REQUIRE(moves < 20);
+      for (int i = 1; i <= 1000; ++i) {
+         REQUIRE(a(i) == i);
+      }
+
+      // shrinking keeps the storage
+      a.reallocate(keep, 10);
+      REQUIRE(a.data() == last);
+      REQUIRE(a.size() == 10);
+      REQUIRE(a(10) == 10);
+      a.deallocate();
+      REQUIRE(a.capacity() == 0);
+   }
+
+   SECTION("fortran indices map to the same elements")
+   {
+      allocatable<int, 1, 1> a;
+      a.allocate(3, 4);
+      for (int j = 1; j <= 4; ++j)
+         for (int i = 1; i <= 3; ++i)
+            a(i, j) = 10 * i + j;
+
+      a.reallocate(keep, bounds(0, 4), bounds(2, 6));
+      REQUIRE(a.lbound(1) == 0);
+      REQUIRE(a.ubound(2) == 6);
+      REQUIRE(a.size() == 25);
+      for (int j = 2; j <= 4; ++j)
+         for (int i = 1; i <= 3; ++i)
+            REQUIRE(a(i, j) == 10 * i + j);
+
+      a.reallocate(keep, 2, 3);
+      REQUIRE(a.size() == 6);
+      for (int j = 2; j <= 3; ++j)
+         REQUIRE(a(1, j) == 10 + j);
+   }
+
+   SECTION("c/c++ resize keeps the leading block")
+   {
+      allocatable<double, 0, 0> c;
+      c.resize(keep, 2, 3);
+      for (int i = 0; i < 2; ++i)
+         for (int j = 0; j < 3; ++j)
+            c[i][j] = i * 3 + j;
+      c.resize(keep, 4, 2);
+      REQUIRE(c.size(1) == 2);
+      REQUIRE(c.size(2) == 4);
+      for (int i = 0; i < 2; ++i)
+         for (int j = 0; j < 2; ++j)
+            REQUIRE(c[i][j] == i * 3 + j);
+   }
+
+   SECTION("non-trivial elements are moved")
+   {
+      {
+         allocatable<counted, 1, 1> a;
+         a.allocate(2, 2);
+         a(2, 2).value = 7;
+         a.reallocate(keep, 3, 3);
+         REQUIRE(counted::alive == 9);
+         REQUIRE(a(2, 2).value == 7);
+         REQUIRE(a(3, 3).value == 42);
+         a.reallocate(keep, 3, 1);
+         REQUIRE(counted::alive == 3);
+      }
+      REQUIRE(counted::alive == 0);
+   }
+}
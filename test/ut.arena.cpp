@@ -0,0 +1,72 @@
+#include "FortranArray"
+#include "catch.hpp"
+#include <thread>
+using namespace fa;
+
+TEST_CASE("arena allocator", "[arena]")
+{
+   SECTION("same-shaped scratch arrays reuse their blocks")
+   {
+      arena ar(1 << 16);
+      using scratch = basic_allocatable<double, arena_allocator<double>, 1, 1>;
+      const double* start = nullptr;
+      for (int step = 0; step < 10; ++step) {
+         scratch a(arena_allocator<double>{ar}), b(arena_allocator<double>{ar});
+         a.allocate(30, 20);
+         b.allocate(30, 20);
+         if (step == 0)
+            start = a.data();
+         REQUIRE(reinterpret_cast<std::uintptr_t>(a.data()) % 64 == 0);
+         a.fill(step);
+         b = a * 2.0;
+         REQUIRE(b(30, 20) == 2 * step);
+      }
+      const arena::statistics& st = ar.stats();
+      REQUIRE(st.allocations == 20);
+      REQUIRE(st.reused == 18);
+      REQUIRE(st.live == 0);
+      REQUIRE(st.bytes == 20 * 30 * 20 * sizeof(double));
+      REQUIRE(st.capacity == (1 << 16));
+
+      // reset rewinds to the start of the first chunk
+      scratch c(arena_allocator<double>{ar});
+      c.allocate(8, 8);
+      REQUIRE(c.data() != start);
+      REQUIRE_THROWS_AS(ar.reset(), std::logic_error);
+      c.deallocate();
+      ar.reset();
+      c.allocate(8, 8);
+      REQUIRE(c.data() == start);
+   }
+
+   SECTION("large blocks and thread-local arenas")
+   {
+      arena ar(1024);
+      arena_allocator<int> al(ar);
+      int* p = al.allocate(10000);
+      REQUIRE(ar.stats().capacity >= 10000 * sizeof(int));
+      al.deallocate(p, 10000);
+
+      arena* other = nullptr;
+      std::thread t([&other]() {
+         arena_allocatable<int, 1> a;
+         a.allocate(100);
+         other = &a.get_allocator().get_arena();
+      });
+      t.join();
+      arena_allocatable<int, 1> a;
+      REQUIRE(&a.get_allocator().get_arena() == &arena::local());
+      REQUIRE(other != &arena::local());
+
+      // constructed here, allocated by a worker: the worker's arena
+      arena_allocatable<int, 1> b;
+      arena* used = nullptr;
+      std::thread w([&b, &used]() {
+         b.allocate(100);
+         used = &b.get_allocator().get_arena();
+         b.deallocate();
+      });
+      w.join();
+      REQUIRE(used != &arena::local());
+   }
+}
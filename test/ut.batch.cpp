@@ -0,0 +1,130 @@
+#define FA_WITH_THREADS
+#include "FortranArray"
+#include "catch.hpp"
+#include <cmath>
+using namespace fa;
+
+namespace {
+double value(index_t k, index_t i, index_t j)
+{
+   return std::sin(0.7 * k + 1.3 * i + 0.4 * j * j);
+}
+}
+
+TEST_CASE("batch of dimension arrays", "[batch]")
+{
+   // not a multiple of the simd width, so that the scalar lanes are used
+   const index_t n = 37;
+
+   SECTION("layout")
+   {
+      batch<dimension<double, 2, 3>> a(n);
+      REQUIRE(a.size() == n);
+      REQUIRE(a.stride() >= n);
+      REQUIRE(a.stride() % simd_width<double>::value == 0);
+      a(5, 2, 3) = 1.5;
+      REQUIRE(a.slice(2, 3) == a.data() + 5 * a.stride());
+      REQUIRE(a.slice(2, 3)[4] == 1.5);
+
+      dimension<double, 2, 3> m;
+      for (index_t j = 1; j <= 3; ++j)
+         for (index_t i = 1; i <= 2; ++i)
+            m(i, j) = 10 * i + j;
+      a.set(7, m);
+      REQUIRE(a(7, 2, 1) == 21);
+      dimension<double, 2, 3> g = a.get(7);
+      REQUIRE(g(1, 3) == 13);
+
+      a.deallocate();
+      REQUIRE(!a.allocated());
+      REQUIRE(a.size() == 0);
+   }
+
+   SECTION("gemm and gemv")
+   {
+      batch<dimension<double, 3, 4>> a(n);
+      batch<dimension<double, 4, 2>> b(n);
+      batch<dimension<double, 4>> x(n);
+      for (index_t k = 1; k <= n; ++k) {
+         for (index_t l = 1; l <= 4; ++l) {
+            for (index_t i = 1; i <= 3; ++i)
+               a(k, i, l) = value(k, i, l);
+            for (index_t j = 1; j <= 2; ++j)
+               b(k, l, j) = value(k, l + 5, j);
+            x(k, l) = value(k, 0, l);
+         }
+      }
+
+      batch<dimension<double, 3, 2>> c;
+      batch<dimension<double, 3>> y;
+      batch_gemm(a, b, c);
+      batch_gemv(a, x, y);
+      REQUIRE(c.size() == n);
+      for (index_t k = 1; k <= n; ++k) {
+         for (index_t i = 1; i <= 3; ++i) {
+            double yi = 0;
+            for (index_t l = 1; l <= 4; ++l)
+               yi += a(k, i, l) * x(k, l);
+            REQUIRE(y(k, i) == Approx(yi));
+            for (index_t j = 1; j <= 2; ++j) {
+               double cij = 0;
+               for (index_t l = 1; l <= 4; ++l)
+                  cij += a(k, i, l) * b(k, l, j);
+               REQUIRE(c(k, i, j) == Approx(cij));
+            }
+         }
+      }
+
+      thread_pool pool(3);
+      batch<dimension<double, 3, 2>> c2;
+      batch_gemm(a, b, c2, pool);
+      for (index_t e = 0; e < 6; ++e)
+         for (index_t k = 0; k < n; ++k)
+            REQUIRE(c2.data()[e * c2.stride() + k] ==
+                    c.data()[e * c.stride() + k]);
+
+      batch<dimension<double, 4, 2>> short_b(n - 1);
+      REQUIRE_THROWS_AS(batch_gemm(a, short_b, c), std::invalid_argument);
+   }
+
+   SECTION("lu solve")
+   {
+      batch<dimension<double, 4, 4>> a(n), lu(n);
+      batch<dimension<double, 4>> b(n), x(n);
+      for (index_t k = 1; k <= n; ++k) {
+         for (index_t j = 1; j <= 4; ++j) {
+            for (index_t i = 1; i <= 4; ++i)
+               a(k, i, j) = value(k, i * j, i + j);
+            b(k, j) = j;
+         }
+         // a zero leading entry needs a row exchange
+         if (k % 3 == 0)
+            a(k, 1, 1) = 0;
+      }
+      std::copy(a.data(), a.data() + 16 * a.stride(), lu.data());
+      std::copy(b.data(), b.data() + 4 * b.stride(), x.data());
+
+      batch<dimension<int, 4>> piv;
+      batch_lu(lu, piv);
+      batch_lu_solve(lu, piv, x);
+      for (index_t k = 1; k <= n; ++k) {
+         if (k % 3 == 0)
+            REQUIRE(piv(k, 1) != 1);
+         for (index_t i = 1; i <= 4; ++i) {
+            double r = 0;
+            for (index_t j = 1; j <= 4; ++j)
+               r += a(k, i, j) * x(k, j);
+            REQUIRE(r == Approx(b(k, i)).margin(1e-9));
+         }
+      }
+
+      thread_pool pool(2);
+      batch<dimension<double, 4, 4>> lu2(n);
+      batch<dimension<int, 4>> piv2;
+      std::copy(a.data(), a.data() + 16 * a.stride(), lu2.data());
+      batch_lu(lu2, piv2, pool);
+      for (index_t k = 1; k <= n; ++k)
+         for (index_t i = 1; i <= 4; ++i)
+            REQUIRE(piv2(k, i) == piv(k, i));
+   }
+}
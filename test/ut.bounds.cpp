@@ -0,0 +1,62 @@
+#include "FortranArray"
+#include "catch.hpp"
+using namespace fa;
+
+// built with FA_BOUNDS_CHECK by the testcheck target
+
+#ifdef FA_BOUNDS_CHECK
+TEST_CASE("bounds checking", "[bounds]")
+{
+   SECTION("dimension and tensor")
+   {
+      dimension<int, 3, r(-1, 1)> d;
+      d(3, -1) = 1;
+      REQUIRE_THROWS_AS(d(4, 0), std::out_of_range);
+      REQUIRE_THROWS_AS(d(1, 2), std::out_of_range);
+      REQUIRE_THROWS_AS(d.c(3, 0), std::out_of_range);
+      REQUIRE_THROWS_AS(d[3], std::out_of_range);
+
+      tensor<int, 2, 5> t;
+      t.c(1, 4) = 1;
+      REQUIRE_THROWS_AS(t.c(2, 0), std::out_of_range);
+      REQUIRE_THROWS_AS(t.c(0, 5), std::out_of_range);
+   }
+
+   SECTION("allocatable reports the dimension and the bounds")
+   {
+      allocatable<double, 1, 1, 1> a;
+      a.allocate(4, bounds{-2, 2}, 3);
+      a(4, 2, 3) = 1;
+      a[2][4][3] = 1;
+      try {
+         a(1, 3, 1);
+         FAIL("no exception");
+      } catch (const std::out_of_range& e) {
+         REQUIRE(std::string(e.what()) ==
+                 "index 3 is out of bounds [-2, 2] of dimension 2.");
+      }
+      REQUIRE_THROWS_AS(a(0, 0, 1), std::out_of_range);
+      REQUIRE_THROWS_AS(a.c(3, 0, 0), std::out_of_range);
+      REQUIRE_THROWS_AS(a[3], std::out_of_range);
+      REQUIRE_THROWS_AS(a[0][5], std::out_of_range);
+      REQUIRE_THROWS_AS(a[0][0][-1], std::out_of_range);
+      REQUIRE_THROWS_AS(a.section(all, 3, all), std::out_of_range);
+      REQUIRE_THROWS_AS(a.section(triplet(1, 5), all, 1), std::out_of_range);
+   }
+
+   SECTION("views and mixed extents")
+   {
+      allocatable<int, 1, 1> a;
+      a.allocate(6, 6);
+      auto v = a.section(triplet(1, 6, 2), all);
+      v(3, 6) = 1;
+      REQUIRE_THROWS_AS(v(4, 1), std::out_of_range);
+
+      mixed_allocatable<int, 3, dyn> m;
+      m.allocate(2);
+      m(3, 2) = 1;
+      REQUIRE_THROWS_AS(m(4, 1), std::out_of_range);
+      REQUIRE_THROWS_AS(m.c(2, 0), std::out_of_range);
+   }
+}
+#endif
@@ -141,6 +141,31 @@ TEST_CASE("range tests", "[range]")
       REQUIRE(rf2.size() == size);
       REQUIRE(rf3.size() == size);
    }
+
+#ifdef FA_WIDE_RANGE
+   SECTION("wide range mode")
+   {
+      REQUIRE(sizeof(index_t) == 8);
+      REQUIRE(sizeof(r::code_t) == 2 * sizeof(std::size_t));
+#   if defined(__SIZEOF_INT128__) && UINTPTR_MAX > 0xFFFFFFFFu
+      constexpr index_t big = 5000000000;
+      constexpr auto rb = r(-big, big);
+      static_assert(rb.front() == -big, "");
+      static_assert(rb.size() == 2 * big + 1, "");
+      static_assert(r::_1(3 * big) == r(1, 3 * big), "");
+      static_assert(detail_d::P<3 * big, 2>::prod == 6 * big, "");
+#   endif
+   }
+#endif
+
+#if defined(FA_WIDE_RANGE) != (UINTPTR_MAX > 0xFFFFFFFFu)
+   SECTION("64-bit indices beyond the 32-bit fields are rejected")
+   {
+      const index_t big = index_t(1) << 40;
+      REQUIRE_THROWS_AS(r(0, big), std::out_of_range);
+      REQUIRE_THROWS_AS(r(-big, 0), std::out_of_range);
+   }
+#endif
 }
 
 TEST_CASE("dimension with different initial index", "[dimension]")
@@ -531,4 +556,30 @@ TEST_CASE("c/c++-like array", "[array]")
          }
       }
    }
+
+   SECTION("2 dimensional with different initial indices")
+   {
+      constexpr int size = 6;
+      tensor<int, r(0, 1), r(5, 7)> cc;
+      REQUIRE(size == cc.size());
+      REQUIRE(cc.lbound(1) == 5);
+      REQUIRE(cc.lbound(2) == 0);
+      REQUIRE(cc.ubound(1) == 7);
+      REQUIRE(cc.ubound(2) == 1);
+
+      int* pc = cc.data();
+      for (int i = 0; i < size; ++i) {
+         pc[i] = i;
+      }
+
+      int count = 0;
+      for (int a = 0; a < 2; ++a) {
+         for (int b = 0; b < 3; ++b) {
+            REQUIRE(count == cc(5 + b, a));
+            REQUIRE(count == cc[a][b]);
+            REQUIRE(count == cc.c(a, b));
+            ++count;
+         }
+      }
+   }
 }
@@ -0,0 +1,114 @@
+#define FA_WITH_THREADS
+#include "FortranArray"
+#include "catch.hpp"
+#include <set>
+#include <vector>
+using namespace fa;
+
+TEST_CASE("executors", "[exec]")
+{
+   SECTION("static partition covers [0, n) once")
+   {
+      thread_pool pool(4);
+      REQUIRE(pool.size() == 4);
+      for (index_t n : {0, 1, 3, 4, 17, 1000}) {
+         std::vector<int> hits(n, 0);
+         pool.parallel_for(n, [&hits](index_t b, index_t e) {
+            for (index_t i = b; i < e; ++i) {
+               ++hits[i];
+            }
+         });
+         for (index_t i = 0; i < n; ++i) {
+            REQUIRE(hits[i] == 1);
+         }
+      }
+   }
+
+   SECTION("exceptions are rethrown by the calling thread")
+   {
+      thread_pool pool(3);
+      REQUIRE_THROWS_AS(pool.parallel_for(3,
+                                          [](index_t b, index_t) {
+                                             if (b == 2)
+                                                throw std::runtime_error("");
+                                          }),
+                        std::runtime_error);
+      // the pool is still usable
+      int count = 0;
+      pool.parallel_for(1, [&count](index_t, index_t) { ++count; });
+      REQUIRE(count == 1);
+   }
+
+   SECTION("a job may use the pool that runs it")
+   {
+      thread_pool pool(3);
+      std::vector<index_t> counts(6, 0);
+      pool.parallel_for(6, [&](index_t b, index_t e) {
+         for (index_t i = b; i < e; ++i) {
+            pool.parallel_for(100, [&counts, i](index_t bb, index_t ee) {
+               counts[i] += ee - bb;
+            });
+         }
+      });
+      for (int i = 0; i < 6; ++i) {
+         REQUIRE(counts[i] == 100);
+      }
+      std::vector<int> hits(3 * 3, 0);
+      pool.run([&](int tid, int) {
+         pool.run([&](int t, int n) { ++hits[tid * n + t]; });
+      });
+      for (int i = 0; i < 9; ++i) {
+         REQUIRE(hits[i] == 1);
+      }
+   }
+}
+
+TEST_CASE("parallel fill, copy and transform", "[exec]")
+{
+   thread_pool pool(4);
+
+   SECTION("allocatable")
+   {
+      allocatable<double, 1, 1, 1> a, b;
+      a.allocate(5, 6, 7);
+      b.allocate(5, 6, 7);
+      a.fill(2.5, pool);
+      for (int i = 0; i < a.size(); ++i) {
+         REQUIRE(a.data()[i] == 2.5);
+      }
+      b.zero(pool);
+      REQUIRE(b(5, 6, 7) == 0);
+
+      for (int i = 0; i < a.size(); ++i) {
+         a.data()[i] = i;
+      }
+      copy(b, a, pool);
+      for (int i = 0; i < b.size(); ++i) {
+         REQUIRE(b.data()[i] == i);
+      }
+      transform(b, a, [](double x) { return 2 * x + 1; }, pool);
+      for (int i = 0; i < b.size(); ++i) {
+         REQUIRE(b.data()[i] == 2 * i + 1);
+      }
+      assign(b, a * a - 1, pool);
+      for (int i = 0; i < b.size(); ++i) {
+         REQUIRE(b.data()[i] == i * i - 1);
+      }
+
+      allocatable<double, 1> c;
+      c.allocate(3);
+      REQUIRE_THROWS_AS(copy(c, a, pool), std::invalid_argument);
+   }
+
+   SECTION("dimension")
+   {
+      dimension<int, 4, 9> d;
+      tensor<int, 9, 4> t;
+      d.fill(3, pool);
+      t.zero(serial());
+      transform(t, d, [](int x) { return x * x; }, pool);
+      REQUIRE(t[8][3] == 9);
+      copy(d, t, serial());
+      REQUIRE(d(4, 9) == 9);
+   }
+}
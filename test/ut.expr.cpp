@@ -0,0 +1,116 @@
+#include "FortranArray"
+#include "catch.hpp"
+using namespace fa;
+
+TEST_CASE("array expressions on dimension and tensor", "[expr]")
+{
+   SECTION("fused arithmetic")
+   {
+      dimension<double, 3, 4> a, b, c;
+      for (int i = 0; i < b.size(); ++i) {
+         b.data()[i] = i;
+         c.data()[i] = 2 * i + 1;
+      }
+
+      const double alpha = 0.5;
+      a = b + alpha * c;
+      for (int i = 0; i < a.size(); ++i) {
+         REQUIRE(a.data()[i] == i + alpha * (2 * i + 1));
+      }
+
+      a = (b - c) / 2.0 + 1;
+      for (int i = 0; i < a.size(); ++i) {
+         REQUIRE(a.data()[i] == (i - (2.0 * i + 1)) / 2.0 + 1);
+      }
+
+      a = -b * b;
+      REQUIRE(a(3, 4) == -121);
+
+      a = 3.0;
+      a += b;
+      a *= 2;
+      a -= c;
+      a /= 5;
+      for (int i = 0; i < a.size(); ++i) {
+         REQUIRE(a.data()[i] == Approx(((3.0 + i) * 2 - (2 * i + 1)) / 5));
+      }
+   }
+
+   SECTION("tensor and dimension of the same fortran shape")
+   {
+      dimension<int, 3, 4> f;
+      tensor<int, 4, 3> t;
+      for (int i = 0; i < t.size(); ++i) {
+         t.data()[i] = i;
+      }
+      f = t * t;
+      REQUIRE(f(3, 4) == t[3][2] * t[3][2]);
+   }
+
+   SECTION("elemental functions")
+   {
+      dimension<double, 5> a, b;
+      for (int i = 1; i <= 5; ++i) {
+         b(i) = i;
+      }
+      a = sqrt(b * b) + abs(-b) + exp(log(b));
+      for (int i = 1; i <= 5; ++i) {
+         REQUIRE(a(i) == Approx(3.0 * i));
+      }
+      a = max(b, 3.0) - min(b, 3.0) + pow(b, 2);
+      REQUIRE(a(1) == Approx(2 + 1));
+      REQUIRE(a(5) == Approx(2 + 25));
+      a = sin(b) * sin(b) + cos(b) * cos(b) + tan(b * 0);
+      REQUIRE(a(4) == Approx(1));
+   }
+}
+
+TEST_CASE("array expressions on allocatable", "[expr]")
+{
+   SECTION("allocation on assignment")
+   {
+      allocatable<double, 1, 1> a, b, c;
+      b.allocate(3, 4);
+      c.allocate(3, 4);
+      b = 1.0;
+      c = 2.0;
+      a = b + 2 * c;
+      REQUIRE(a.allocated());
+      REQUIRE(a.size(1) == 3);
+      REQUIRE(a.size(2) == 4);
+      for (int i = 0; i < a.size(); ++i) {
+         REQUIRE(a.data()[i] == 5);
+      }
+   }
+
+   SECTION("mixed with static arrays")
+   {
+      allocatable<double, 1, 1> a;
+      dimension<double, 3, 4> d;
+      d = 1.5;
+      a.allocate(3, 4);
+      a = d;
+      a += d * 2;
+      REQUIRE(a(3, 4) == 4.5);
+      d = a - 1;
+      REQUIRE(d(1, 1) == 3.5);
+   }
+
+   SECTION("runtime shape checks")
+   {
+      allocatable<double, 1, 1> a, b;
+      a.allocate(3, 4);
+      b.allocate(4, 3);
+      a = 0.0;
+      b = 0.0;
+      REQUIRE_THROWS_AS(a = b + 1, std::invalid_argument);
+      REQUIRE_THROWS_AS(a += b, std::invalid_argument);
+      dimension<double, 4, 3> d;
+      d = 2.0;
+      REQUIRE_THROWS_AS(a = d, std::invalid_argument);
+      REQUIRE_NOTHROW(b = d);
+      for (int j = 1; j <= 3; ++j)
+         for (int i = 1; i <= 4; ++i)
+            REQUIRE(b(i, j) == 2.0);
+   }
+}
@@ -0,0 +1,145 @@
+#include "FortranArray"
+#include "catch.hpp"
+#include <thread>
+#include <vector>
+using namespace fa;
+
+namespace {
+using dir2 = std::array<int, 2>;
+
+std::vector<dir2> neighbors2()
+{
+   std::vector<dir2> dirs;
+   for (int j = -1; j <= 1; ++j)
+      for (int i = -1; i <= 1; ++i)
+         if (i != 0 || j != 0)
+            dirs.push_back(dir2{{i, j}});
+   return dirs;
+}
+
+dir2 opposite(const dir2& d)
+{
+   return dir2{{-d[0], -d[1]}};
+}
+
+int wrap(int i, int n)
+{
+   return ((i - 1) % n + n) % n + 1;
+}
+
+double field(int i, int j)
+{
+   return 1000 * i + j;
+}
+}
+
+TEST_CASE("halo allocatable", "[halo]")
+{
+   SECTION("interior and full bounds")
+   {
+      halo_allocatable<double, 1, 1, 1> u;
+      u.allocate(1, 6, 5, bounds(0, 3));
+      REQUIRE(u.size() == 120);
+      REQUIRE(u.lbound(3) == 0);
+      REQUIRE(u.ubound(1) == 6);
+      REQUIRE(u.full().lbound(1) == 0);
+      REQUIRE(u.full().ubound(3) == 4);
+      REQUIRE(u.full().size() == 8 * 7 * 6);
+      REQUIRE(&u(0, 0, -1) == u.full().data());
+      REQUIRE(u.interior().size() == 120);
+      REQUIRE(&u.interior()(1, 1, 0) == &u(1, 1, 0));
+
+      using dir3 = std::array<int, 3>;
+      REQUIRE(u.halo_size(dir3{{1, 0, 0}}) == 5 * 4);
+      REQUIRE(u.halo_size(dir3{{0, -1, 1}}) == 6);
+      REQUIRE(u.halo_size(dir3{{-1, 1, 1}}) == 1);
+      REQUIRE(&u.send_region(dir3{{1, -1, 0}})(6, 1, 0) == &u(6, 1, 0));
+      REQUIRE(&u.recv_region(dir3{{1, -1, 0}})(7, 0, 0) == &u(7, 0, 0));
+      REQUIRE_THROWS_AS(u.halo_size(dir3{{2, 0, 0}}), std::invalid_argument);
+
+      halo_allocatable<int, 1> v;
+      REQUIRE_THROWS_AS(v.allocate(3, 2), std::invalid_argument);
+   }
+
+   SECTION("periodic exchange with itself")
+   {
+      const int nx = 7, ny = 5, w = 2;
+      halo_allocatable<double, 1, 1> u;
+      u.allocate(w, nx, ny);
+      u.fill(-1);
+      for (int j = 1; j <= ny; ++j)
+         for (int i = 1; i <= nx; ++i)
+            u(i, j) = field(i, j);
+
+      std::vector<double> buf;
+      for (const dir2& d : neighbors2()) {
+         buf.resize(u.halo_size(d));
+         REQUIRE(u.pack(d, buf.data()) == u.halo_size(d));
+         // what is sent towards d arrives from the opposite side
+         REQUIRE(u.unpack(opposite(d), buf.data()) == u.halo_size(d));
+      }
+      for (int j = 1 - w; j <= ny + w; ++j)
+         for (int i = 1 - w; i <= nx + w; ++i)
+            REQUIRE(u(i, j) == field(wrap(i, nx), wrap(j, ny)));
+   }
+
+   SECTION("threads standing in for message passing")
+   {
+      // a periodic 24 x 18 domain split over 2 x 3 ranks of 12 x 6
+      const int px = 2, py = 3, mx = 12, my = 6, w = 2;
+      const int nrank = px * py, nx = px * mx, ny = py * my;
+      const std::vector<dir2> dirs = neighbors2();
+      std::vector<halo_allocatable<double, 1, 1>> sub(nrank);
+      std::vector<std::vector<std::vector<double>>> mailbox(
+         nrank, std::vector<std::vector<double>>(dirs.size()));
+      auto rank_of = [&](int rx, int ry) {
+         return (rx + px) % px + ((ry + py) % py) * px;
+      };
+
+      // every rank fills its interior and posts its halos
+      std::vector<std::thread> team;
+      for (int r = 0; r < nrank; ++r) {
+         team.emplace_back([&, r]() {
+            const int ox = (r % px) * mx, oy = (r / px) * my;
+            halo_allocatable<double, 1, 1>& u = sub[r];
+            u.allocate(w, mx, my);
+            u.fill(-1);
+            for (int j = 1; j <= my; ++j)
+               for (int i = 1; i <= mx; ++i)
+                  u(i, j) = field(ox + i, oy + j);
+            for (std::size_t n = 0; n < dirs.size(); ++n) {
+               mailbox[r][n].resize(u.halo_size(dirs[n]));
+               u.pack(dirs[n], mailbox[r][n].data());
+            }
+         });
+      }
+      for (std::thread& t : team)
+         t.join();
+      team.clear();
+
+      // every rank receives from its neighbours, which sent towards it
+      for (int r = 0; r < nrank; ++r) {
+         team.emplace_back([&, r]() {
+            for (std::size_t n = 0; n < dirs.size(); ++n) {
+               const dir2& d = dirs[n];
+               const int nb = rank_of(r % px + d[0], r / px + d[1]);
+               const dir2 back = opposite(d);
+               std::size_t m = 0;
+               while (dirs[m] != back)
+                  ++m;
+               sub[r].unpack(d, mailbox[nb][m].data());
+            }
+         });
+      }
+      for (std::thread& t : team)
+         t.join();
+
+      for (int r = 0; r < nrank; ++r) {
+         const int ox = (r % px) * mx, oy = (r / px) * my;
+         for (int j = 1 - w; j <= my + w; ++j)
+            for (int i = 1 - w; i <= mx + w; ++i)
+               REQUIRE(sub[r](i, j) ==
+                       field(wrap(ox + i, nx), wrap(oy + j, ny)));
+      }
+   }
+}
@@ -0,0 +1,209 @@
+#define FA_WITH_IO
+#include "FortranArray"
+#include "catch.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+using namespace fa;
+
+TEST_CASE("binary save and load", "[io]")
+{
+   SECTION("round trip keeps the extents and lower bounds")
+   {
+      allocatable<double, 1, 1, 1> a;
+      a.allocate(bounds{-1, 3}, 4, bounds{0, 2});
+      for (int k = 0; k <= 2; ++k) {
+         for (int j = 1; j <= 4; ++j) {
+            for (int i = -1; i <= 3; ++i) {
+               a(i, j, k) = 100 * k + 10 * j + i;
+            }
+         }
+      }
+      std::stringstream ss;
+      save(ss, a);
+
+      allocatable<double, 1, 1, 1> b;
+      b.allocate(2, 2, 2);
+      load(ss, b);
+      for (int d = 1; d <= 3; ++d) {
+         REQUIRE(b.lbound(d) == a.lbound(d));
+         REQUIRE(b.ubound(d) == a.ubound(d));
+      }
+      REQUIRE(b(-1, 1, 0) == -1 + 10);
+      REQUIRE(b(3, 4, 2) == 243);
+
+      // wrong element type, rank or extents
+      ss.seekg(0);
+      allocatable<float, 1, 1, 1> f;
+      REQUIRE_THROWS_AS(load(ss, f), std::invalid_argument);
+      ss.seekg(0);
+      allocatable<double, 1, 1> r2;
+      REQUIRE_THROWS_AS(load(ss, r2), std::invalid_argument);
+      ss.seekg(0);
+      dimension<double, 5, 4, 2> d;
+      REQUIRE_THROWS_AS(load(ss, d), std::invalid_argument);
+
+      std::stringstream junk("not an array");
+      REQUIRE_THROWS_AS(load(junk, b), std::runtime_error);
+   }
+
+   SECTION("corrupted extents and failed writes")
+   {
+      allocatable<int, 1, 1> a;
+      a.allocate(3, 2);
+      a.fill(1);
+      std::stringstream ss;
+      save(ss, a);
+      const std::string good = ss.str();
+      // the extents follow the 40 bytes of the fixed header
+      auto patched = [&good](std::int64_t d1, std::int64_t d2) {
+         std::string s = good;
+         std::memcpy(&s[40], &d1, 8);
+         std::memcpy(&s[48], &d2, 8);
+         return s;
+      };
+      allocatable<int, 1, 1> b;
+      std::stringstream neg(patched(-3, 2));
+      REQUIRE_THROWS_AS(load(neg, b), std::runtime_error);
+      const std::int64_t huge = std::int64_t(1) << 40;
+      std::stringstream big(patched(huge, huge));
+      REQUIRE_THROWS_AS(load(big, b), std::runtime_error);
+      REQUIRE(!b.allocated());
+
+      // a full device fails when the buffered data is flushed at close
+      if (std::ofstream("/dev/full"))
+         REQUIRE_THROWS_AS(save("/dev/full", a), std::runtime_error);
+   }
+
+   SECTION("static arrays")
+   {
+      tensor<int, 2, 3> t, u;
+      for (int i = 0; i < 2; ++i) {
+         for (int j = 0; j < 3; ++j) {
+            t[i][j] = 10 * i + j;
+         }
+      }
+      std::stringstream ss;
+      save(ss, t);
+      load(ss, u);
+      REQUIRE(u[1][2] == 12);
+
+      // into an allocatable, with the extents in fortran order
+      ss.seekg(0);
+      allocatable<int, 1, 1> a;
+      load(ss, a);
+      REQUIRE(a.size(1) == 3);
+      REQUIRE(a.c(1, 2) == 12);
+   }
+
+#ifdef FA_HAVE_MMAP
+   SECTION("memory-mapped view")
+   {
+      const char* file = "ut.io.tmp";
+      allocatable<float, 1, 1> a;
+      a.allocate(bounds{0, 99}, bounds{2, 31});
+      for (int j = 2; j <= 31; ++j) {
+         for (int i = 0; i <= 99; ++i) {
+            a(i, j) = i + 1000 * j;
+         }
+      }
+      save(file, a);
+      {
+         mapped<float, 2> m(file);
+         const view<const float, 2>& v = m.as_view();
+         REQUIRE(m.layout() == 'f');
+         REQUIRE(v.lbound(2) == 2);
+         REQUIRE(v.size() == a.size());
+         REQUIRE(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0);
+         REQUIRE(v(99, 31) == a(99, 31));
+         REQUIRE(v(0, 2) == a(0, 2));
+
+         mapped<float, 2> n(std::move(m));
+         REQUIRE(n.as_view()(5, 7) == a(5, 7));
+      }
+      REQUIRE_THROWS_AS((mapped<double, 2>(file)), std::invalid_argument);
+      std::remove(file);
+   }
+#endif
+}
+
+TEST_CASE("double-buffered slab streaming", "[io]")
+{
+   const char* file = "ut.io.slab.tmp";
+
+   SECTION("writer and reader with a thinner last slab")
+   {
+      const int nx = 5, ny = 4, nz = 11;
+      {
+         slab_writer<double, 3> w(file, {{nx, ny, nz}}, {{0, 1, -3}}, 3);
+         REQUIRE(w.slabs() == 4);
+         int count = 0;
+         while (w.next()) {
+            view<double, 3> s = w.slab();
+            REQUIRE(s.lbound(3) == -3 + 3 * count);
+            REQUIRE(s.size(3) == (count < 3 ? 3 : 2));
+            for (index_t k = s.lbound(3); k <= s.ubound(3); ++k)
+               for (int j = 1; j <= ny; ++j)
+                  for (int i = 0; i < nx; ++i)
+                     s(i, j, k) = 100 * k + 10 * j + i;
+            ++count;
+         }
+         REQUIRE(count == 4);
+         w.close();
+      }
+
+      allocatable<double, 1, 1, 1> a;
+      load(file, a);
+      REQUIRE(a.lbound(3) == -3);
+      REQUIRE(a.ubound(3) == 7);
+      REQUIRE(a(4, 4, 7) == 744);
+      REQUIRE(a(0, 1, -3) == -290);
+
+      slab_reader<double, 3> r(file, 4);
+      REQUIRE(r.slabs() == 3);
+      REQUIRE(r.lbound(3) == -3);
+      REQUIRE(r.ubound(2) == 4);
+      index_t planes = 0;
+      while (r.next()) {
+         view<double, 3> s = r.slab();
+         REQUIRE(s.lbound(1) == 0);
+         for (index_t k = s.lbound(3); k <= s.ubound(3); ++k)
+            for (int j = 1; j <= ny; ++j)
+               for (int i = 0; i < nx; ++i)
+                  REQUIRE(s(i, j, k) == a(i, j, k));
+         planes += s.size(3);
+      }
+      REQUIRE(planes == nz);
+      REQUIRE(!r.next());
+   }
+
+   SECTION("errors")
+   {
+      {
+         // only the first of two slabs is handed over
+         slab_writer<int, 2> w(file, {{3, 4}}, {{1, 1}}, 2);
+         REQUIRE(w.next());
+         REQUIRE(w.next());
+         REQUIRE_THROWS_AS(w.close(), std::logic_error);
+      }
+      if (std::ofstream("/dev/full")) {
+         // the data fits the stream buffer, so only the close fails
+         slab_writer<int, 2> w("/dev/full", {{3, 4}}, {{1, 1}}, 2);
+         while (w.next()) {
+         }
+         REQUIRE_THROWS_AS(w.close(), std::runtime_error);
+      }
+      REQUIRE_THROWS_AS((slab_reader<int, 2>("no/such/file", 1)),
+                        std::runtime_error);
+      REQUIRE_THROWS_AS((slab_reader<double, 2>(file, 1)),
+                        std::invalid_argument);
+      // the reader stops at the truncated data
+      slab_reader<int, 2> r(file, 1);
+      REQUIRE(r.next());
+      REQUIRE(r.next());
+      REQUIRE_THROWS_AS(r.next(), std::runtime_error);
+   }
+   std::remove(file);
+}
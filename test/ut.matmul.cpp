@@ -0,0 +1,129 @@
+#define FA_WITH_THREADS
+#include "FortranArray"
+#include "catch.hpp"
+#include <cmath>
+using namespace fa;
+
+namespace {
+template <class C, class A, class B>
+void require_product(const C& c, const A& a, const B& b, double tol)
+{
+   const index_t m = a.size(1), k = a.size(2), n = b.size(2);
+   for (index_t j = 0; j < n; ++j) {
+      for (index_t i = 0; i < m; ++i) {
+         double s = 0;
+         for (index_t p = 0; p < k; ++p) {
+            s += a(a.lbound(1) + i, a.lbound(2) + p) *
+                 b(b.lbound(1) + p, b.lbound(2) + j);
+         }
+         REQUIRE(c(c.lbound(1) + i, c.lbound(2) + j) ==
+                 Approx(s).epsilon(tol));
+      }
+   }
+}
+}
+
+TEST_CASE("matmul", "[matmul]")
+{
+   SECTION("odd extents across register tiles and cache blocks")
+   {
+      allocatable<double, 0, -2> a;
+      allocatable<double, 1, 1> b, c;
+      const int m = 37, k = 301, n = 29;
+      a.allocate(m, k);
+      b.allocate(k, n);
+      c.allocate(m, n);
+      for (int j = -2; j < k - 2; ++j) {
+         for (int i = 0; i < m; ++i) {
+            a(i, j) = std::sin(0.1 * i + 0.3 * j);
+         }
+      }
+      for (int j = 1; j <= n; ++j) {
+         for (int i = 1; i <= k; ++i) {
+            b(i, j) = std::cos(0.2 * i - 0.7 * j);
+         }
+      }
+      c.fill(-1);
+      matmul(c, a, b);
+      require_product(c, a, b, 1e-12);
+      c.fill(-1);
+      matmul(c, a, b, thread_pool(3));
+      require_product(c, a, b, 1e-12);
+   }
+
+   SECTION("dimension and integers")
+   {
+      dimension<int, 5, 3> a;
+      dimension<int, 3, 4> b;
+      dimension<int, 5, 4> c;
+      for (int j = 1; j <= 3; ++j) {
+         for (int i = 1; i <= 5; ++i) {
+            a(i, j) = i - 2 * j;
+         }
+      }
+      for (int j = 1; j <= 4; ++j) {
+         for (int i = 1; i <= 3; ++i) {
+            b(i, j) = 3 * i + j;
+         }
+      }
+      matmul(c, a, b);
+      for (int j = 1; j <= 4; ++j) {
+         for (int i = 1; i <= 5; ++i) {
+            int s = 0;
+            for (int p = 1; p <= 3; ++p) {
+               s += a(i, p) * b(p, j);
+            }
+            REQUIRE(c(i, j) == s);
+         }
+      }
+   }
+
+   SECTION("strided sections")
+   {
+      allocatable<double, 1, 1> a, b, c;
+      a.allocate(40, 30);
+      b.allocate(30, 50);
+      c.allocate(20, 30);
+      for (int j = 1; j <= 30; ++j) {
+         for (int i = 1; i <= 40; ++i) {
+            a(i, j) = i + 0.5 * j;
+         }
+      }
+      for (int j = 1; j <= 50; ++j) {
+         for (int i = 1; i <= 30; ++i) {
+            b(i, j) = 0.25 * i - j;
+         }
+      }
+      c.fill(0);
+      // every other row of a, the transpose of a block of b
+      auto as = a.section(triplet(1, 40, 2), triplet(3, 27));
+      auto bs = b.section(triplet(2, 26), triplet(50, 22, -2));
+      auto cs = c.section(all, triplet(1, 30, 2));
+      matmul(cs, as, bs);
+      require_product(cs, as, bs, 1e-12);
+      for (int j = 2; j <= 30; j += 2) {
+         for (int i = 1; i <= 20; ++i) {
+            REQUIRE(c(i, j) == 0);
+         }
+      }
+   }
+
+   SECTION("empty and nonconforming shapes")
+   {
+      allocatable<double, 1, 1> a, b, c;
+      a.allocate(4, 0);
+      b.allocate(0, 3);
+      c.allocate(4, 3);
+      c.fill(7);
+      matmul(c, a, b);
+      for (int j = 1; j <= 3; ++j) {
+         for (int i = 1; i <= 4; ++i) {
+            REQUIRE(c(i, j) == 0);
+         }
+      }
+      b.reallocate(1, 3);
+      REQUIRE_THROWS_AS(matmul(c, a, b), std::invalid_argument);
+      b.reallocate(0, 2);
+      REQUIRE_THROWS_AS(matmul(c, a, b), std::invalid_argument);
+   }
+}
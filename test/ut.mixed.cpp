@@ -0,0 +1,55 @@
+#include "FortranArray"
+#include "catch.hpp"
+using namespace fa;
+
+TEST_CASE("mixed static and dynamic extents", "[mixed]")
+{
+   SECTION("indexing agrees with allocatable")
+   {
+      mixed_allocatable<int, 3, dyn, r(0, 1), dyn> m;
+      allocatable<int, 1, 1, 0, 1> a;
+      REQUIRE(m.allocated() == false);
+      m.allocate(4, bounds{-2, 2});
+      a.allocate(3, 4, 2, bounds{-2, 2});
+      REQUIRE(m.size() == a.size());
+      for (int d = 1; d <= 4; ++d) {
+         REQUIRE(m.size(d) == a.size(d));
+         REQUIRE(m.lbound(d) == a.lbound(d));
+         REQUIRE(m.ubound(d) == a.ubound(d));
+      }
+      for (int l = -2; l <= 2; ++l) {
+         for (int k = 0; k <= 1; ++k) {
+            for (int j = 1; j <= 4; ++j) {
+               for (int i = 1; i <= 3; ++i) {
+                  REQUIRE(m.fortran_index(i, j, k, l) ==
+                          a.fortran_index(i, j, k, l));
+                  REQUIRE(m.c_index(l + 2, k, j - 1, i - 1) ==
+                          a.c_index(l + 2, k, j - 1, i - 1));
+               }
+            }
+         }
+      }
+      // only the dynamic extents are stored
+      REQUIRE(sizeof(m) == sizeof(void*) + 4 * sizeof(index_t));
+   }
+
+   SECTION("expressions, reductions and move")
+   {
+      mixed_allocatable<double, 3, dyn> v, w;
+      v.allocate(1000);
+      v.fill(2);
+      w = v * v + 1.0;
+      REQUIRE(w.size(2) == 1000);
+      REQUIRE(sum(w) == 5 * 3000);
+      REQUIRE(sum(w, 1)(7) == 15);
+
+      mixed_allocatable<double, 3, dyn> u(std::move(w));
+      REQUIRE(w.allocated() == false);
+      REQUIRE(u(3, 1000) == 5);
+
+      allocatable<double, 1, 1> bad;
+      bad.allocate(4, 10);
+      mixed_allocatable<double, 3, dyn> x;
+      REQUIRE_THROWS_AS(x = bad, std::invalid_argument);
+   }
+}
@@ -0,0 +1,121 @@
+#define FA_WITH_THREADS
+#include "FortranArray"
+#include "catch.hpp"
+using namespace fa;
+
+TEST_CASE("reductions", "[reduce]")
+{
+   SECTION("whole-array reductions")
+   {
+      dimension<double, 4, 3> d;
+      for (int j = 1; j <= 3; ++j) {
+         for (int i = 1; i <= 4; ++i) {
+            d(i, j) = 10 * j + i;
+         }
+      }
+      REQUIRE(sum(d) == 4 * (10 + 20 + 30) + 3 * (1 + 2 + 3 + 4));
+      REQUIRE(maxval(d) == 34);
+      REQUIRE(minval(d) == 11);
+      REQUIRE(maxloc(d) == std::array<index_t, 2>{{4, 3}});
+      REQUIRE(minloc(d) == std::array<index_t, 2>{{1, 1}});
+      REQUIRE(sum(d - d) == 0);
+      REQUIRE(dot_product(d, d) == Approx(norm2(d) * norm2(d)));
+      REQUIRE(norm2(d - d) == 0);
+
+      // scaled sums neither overflow nor underflow
+      dimension<double, 2> h;
+      h(1) = 3e200;
+      h(2) = -4e200;
+      REQUIRE(norm2(h) == Approx(5e200));
+      h = h * 1e-200 * 1e-200;
+      REQUIRE(norm2(h) == Approx(5e-200));
+      REQUIRE(norm2(h * 1e-110) > 0);
+
+      // honors the lower bounds; the first extreme element wins
+      allocatable<int, 1> a;
+      a.allocate(bounds{-2, 5});
+      a.zero();
+      a(0) = 7;
+      a(3) = 7;
+      a(-1) = -7;
+      REQUIRE(maxloc(a) == std::array<index_t, 1>{{0}});
+      REQUIRE(minloc(a) == std::array<index_t, 1>{{-1}});
+
+      allocatable<double, 1> e;
+      e.allocate(0);
+      REQUIRE(sum(e) == 0);
+      REQUIRE(minloc(e) == std::array<index_t, 1>{{0}});
+   }
+
+   SECTION("parallel reductions are deterministic")
+   {
+      const int n = 100003;
+      allocatable<double, 1> a, b;
+      a.allocate(n);
+      b.allocate(n);
+      for (int i = 1; i <= n; ++i) {
+         a(i) = 1.0 / i;
+         b(i) = (i % 7) - 3.5;
+      }
+      a(77777) = 2;
+      thread_pool pool(4);
+      REQUIRE(sum(a, pool) == sum(a));
+      REQUIRE(sum(a) == Approx(2 + std::log(n) + 0.5772).epsilon(1e-3));
+      REQUIRE(dot_product(a, b, pool) == dot_product(a, b));
+      REQUIRE(norm2(b, pool) == norm2(b));
+      REQUIRE(maxval(a, pool) == 2);
+      REQUIRE(maxloc(a, pool) == std::array<index_t, 1>{{77777}});
+      REQUIRE(minloc(a, pool) == std::array<index_t, 1>{{n}});
+
+      allocatable<double, 1> c;
+      c.allocate(n - 1);
+      REQUIRE_THROWS_AS(dot_product(a, c), std::invalid_argument);
+   }
+
+   SECTION("reductions along a dimension")
+   {
+      allocatable<int, 1, 1, 1> a;
+      a.allocate(3, 4, 5);
+      for (int k = 1; k <= 5; ++k) {
+         for (int j = 1; j <= 4; ++j) {
+            for (int i = 1; i <= 3; ++i) {
+               a(i, j, k) = 100 * k + 10 * j + i;
+            }
+         }
+      }
+      thread_pool pool(3);
+      for (int dim = 1; dim <= 3; ++dim) {
+         auto s = sum(a, dim);
+         auto p = sum(a, dim, pool);
+         auto mx = maxval(a, dim);
+         auto mn = minval(a, dim, pool);
+         REQUIRE(s.size() == a.size() / a.size(dim));
+         for (int m = 0; m < s.size(); ++m) {
+            REQUIRE(s.data()[m] == p.data()[m]);
+         }
+         for (int k = 1; k <= 5; ++k) {
+            for (int j = 1; j <= 4; ++j) {
+               for (int i = 1; i <= 3; ++i) {
+                  const int v = a(i, j, k);
+                  if (dim == 1) {
+                     REQUIRE(s(j, k) == 6 + 3 * (100 * k + 10 * j));
+                     REQUIRE(mx(j, k) >= v);
+                     REQUIRE(mn(j, k) <= v);
+                  } else if (dim == 2) {
+                     REQUIRE(s(i, k) == 100 + 4 * (100 * k + i));
+                     REQUIRE(mx(i, k) >= v);
+                     REQUIRE(mn(i, k) <= v);
+                  } else {
+                     REQUIRE(s(i, j) == 1500 + 5 * (10 * j + i));
+                     REQUIRE(mx(i, j) >= v);
+                     REQUIRE(mn(i, j) <= v);
+                  }
+               }
+            }
+         }
+      }
+      REQUIRE(maxval(a, 3)(3, 4) == 543);
+      REQUIRE(minval(a, 1)(1, 1) == 111);
+      REQUIRE_THROWS_AS(sum(a, 4), std::out_of_range);
+   }
+}
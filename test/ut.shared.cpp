@@ -0,0 +1,158 @@
+#include "FortranArray"
+#include "catch.hpp"
+#include <thread>
+#include <vector>
+using namespace fa;
+
+TEST_CASE("shared allocatable", "[shared]")
+{
+   allocatable<double, 1, 1> a;
+   a.allocate(bounds(0, 3), 5);
+   for (index_t j = 1; j <= 5; ++j)
+      for (index_t i = 0; i <= 3; ++i)
+         a(i, j) = 10 * i + j;
+   const double* p = a.data();
+
+   shared_allocatable<double, 1, 1> u(std::move(a));
+   REQUIRE(!a.allocated());
+   REQUIRE(u.use_count() == 1);
+   REQUIRE(u.read().data() == p);
+
+   SECTION("copies share the storage until written")
+   {
+      shared_allocatable<double, 1, 1> snap = u;
+      REQUIRE(u.use_count() == 2);
+      REQUIRE(snap.read().data() == p);
+      REQUIRE(snap.lbound(1) == 0);
+      REQUIRE(snap.ubound(2) == 5);
+      REQUIRE(snap(3, 5) == 35);
+
+      u.write()(3, 5) = -1;
+      REQUIRE(u.use_count() == 1);
+      REQUIRE(snap.use_count() == 1);
+      REQUIRE(snap.read().data() == p);
+      REQUIRE(u.read().data() != p);
+      REQUIRE(u(3, 5) == -1);
+      REQUIRE(snap(3, 5) == 35);
+
+      // the copy keeps the bounds and the other elements
+      REQUIRE(u.lbound(1) == 0);
+      REQUIRE(u.ubound(1) == 3);
+      REQUIRE(u.size() == 20);
+      for (index_t j = 1; j <= 5; ++j)
+         for (index_t i = 0; i <= 3; ++i)
+            if (i != 3 || j != 5)
+               REQUIRE(u(i, j) == snap(i, j));
+
+      // the sole owner writes in place
+      const double* q = u.data();
+      u.write()(0, 1) = 7;
+      u.write().c(0, 1) = 8;
+      REQUIRE(u.data() == q);
+      REQUIRE(u(1, 1) == 8);
+   }
+
+   SECTION("reading never copies")
+   {
+      shared_allocatable<double, 1, 1> snap = u;
+      REQUIRE(u(2, 2) == 22);
+      REQUIRE(u.c(1, 2) == 22);
+      REQUIRE(u.data() == p);
+      REQUIRE(u.section(all, 2).size(1) == 4);
+      REQUIRE(sum(u.read()) == sum(snap.read()));
+      REQUIRE(u.use_count() == 2);
+
+      // a section of the written allocatable belongs to u alone
+      view<double, 1> v = u.write().section(all, 2);
+      v(3) = 0;
+      REQUIRE(u(2, 2) == 0);
+      REQUIRE(snap(2, 2) == 22);
+   }
+
+   SECTION("deallocate and allocate leave the other handles")
+   {
+      shared_allocatable<double, 1, 1> snap = u;
+      u.deallocate();
+      REQUIRE(!u.allocated());
+      REQUIRE(u.use_count() == 0);
+      REQUIRE(u.size() == 0);
+      REQUIRE(snap.use_count() == 1);
+      REQUIRE(snap(0, 1) == 1);
+
+      u = snap;
+      u.allocate(2, 2);
+      REQUIRE(u.use_count() == 1);
+      REQUIRE(u.size() == 4);
+      REQUIRE(snap.size() == 20);
+   }
+
+   SECTION("release")
+   {
+      shared_allocatable<double, 1, 1> snap = u;
+      allocatable<double, 1, 1> b = u.release();
+      REQUIRE(!u.allocated());
+      REQUIRE(b.data() != p);
+      REQUIRE(b(3, 4) == 34);
+      REQUIRE(b.lbound(1) == 0);
+
+      allocatable<double, 1, 1> c = snap.release();
+      REQUIRE(c.data() == p);
+      REQUIRE(!snap.allocated());
+   }
+
+   SECTION("snapshots read by other threads")
+   {
+      std::vector<double> sums(4, 0);
+      std::vector<std::thread> ts;
+      for (int t = 0; t < 4; ++t) {
+         shared_allocatable<double, 1, 1> snap = u;
+         ts.push_back(std::thread([snap, t, &sums] {
+            sums[t] = sum(snap.read());
+         }));
+      }
+      u.write().fill(0);
+      for (auto& t : ts)
+         t.join();
+      REQUIRE(u.use_count() == 1);
+      for (int t = 0; t < 4; ++t)
+         REQUIRE(sums[t] == 20 * 15 + 4 * 15);
+      REQUIRE(sum(u.read()) == 0);
+   }
+
+   SECTION("writing after another thread released its copy")
+   {
+      double s = 0;
+      shared_allocatable<double, 1, 1> snap = u;
+      std::thread reader([&s](shared_allocatable<double, 1, 1> h) {
+         s = sum(h.read());
+         h.deallocate();
+      }, std::move(snap));
+      while (u.use_count() > 1)
+         std::this_thread::yield();
+      u.write().fill(2);
+      reader.join();
+      REQUIRE(u.read().data() == p);
+      REQUIRE(s == 20 * 15 + 4 * 15);
+      REQUIRE(sum(u.read()) == 2 * 20);
+   }
+
+   SECTION("empty handles")
+   {
+      shared_allocatable<int, 1> e;
+      REQUIRE(!e.allocated());
+      REQUIRE(e.size() == 0);
+      shared_allocatable<int, 1> f = e;
+      REQUIRE(f.use_count() == 0);
+      e.allocate(3);
+      e.write().fill(1);
+      REQUIRE(sum(e.read()) == 3);
+      swap(e, f);
+      REQUIRE(!e.allocated());
+      REQUIRE(f.size() == 3);
+
+      // writing an empty handle gives it a storage of its own
+      e.write().allocate(2);
+      REQUIRE(e.use_count() == 1);
+      REQUIRE(e.size() == 2);
+   }
+}
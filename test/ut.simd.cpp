@@ -0,0 +1,115 @@
+#include "FortranArray"
+#include "catch.hpp"
+using namespace fa;
+
+TEST_CASE("contiguous spans", "[simd]")
+{
+   SECTION("a whole array is a single span")
+   {
+      allocatable<int, 1, 1, 1> a;
+      a.allocate(bounds(-1, 2), 3, 5);
+      int count = 0;
+      for (auto s : spans(a)) {
+         REQUIRE(s.data == a.data());
+         REQUIRE(s.size == 60);
+         REQUIRE(s.index == (std::array<index_t, 3>{{-1, 1, 1}}));
+         for (int& x : s)
+            x = count++;
+      }
+      REQUIRE(count == 60);
+      REQUIRE(a(2, 3, 5) == 59);
+
+      const dimension<double, 4, 2> d{};
+      int n = 0;
+      for (auto s : spans(d)) {
+         n += s.size;
+         REQUIRE(s[7] == 0.0);
+      }
+      REQUIRE(n == 8);
+   }
+
+   SECTION("a section yields one span per column")
+   {
+      allocatable<int, 1, 1> a;
+      a.allocate(6, 5);
+      a.zero();
+      int runs = 0;
+      for (auto s : spans(a.section(triplet(2, 5), triplet(1, 5, 2)))) {
+         REQUIRE(s.size == 4);
+         REQUIRE(s.index[0] == 1);
+         REQUIRE(s.index[1] == runs + 1);
+         REQUIRE(s.data == &a(2, 2 * runs + 1));
+         for (int& x : s)
+            x = 1;
+         ++runs;
+      }
+      REQUIRE(runs == 3);
+      REQUIRE(sum(a) == 12);
+   }
+
+   SECTION("strided first dimension yields single elements")
+   {
+      allocatable<int, 1, 1> a;
+      a.allocate(6, 2);
+      int runs = 0;
+      for (auto s : spans(a.section(triplet(1, 6, 3), all))) {
+         REQUIRE(s.size == 1);
+         ++runs;
+      }
+      REQUIRE(runs == 4);
+
+      a.deallocate();
+      a.allocate(0, 2);
+      REQUIRE(!(spans(a).begin() != spans(a).end()));
+   }
+}
+
+TEST_CASE("for_each_simd", "[simd]")
+{
+   SECTION("element-wise kernel over arrays of equal shape")
+   {
+      for (int n : {1, 3, 8, 17, 1000}) {
+         allocatable<double, 1, 1> y, x;
+         y.allocate(n, 3);
+         x.allocate(bounds(0, n - 1), 3);
+         for (int j = 1; j <= 3; ++j)
+            for (int i = 1; i <= n; ++i) {
+               y(i, j) = i;
+               x(i - 1, j) = j;
+            }
+         const allocatable<double, 1, 1>& cx = x;
+         for_each_simd([](double& a, const double& b) { a += 2 * b; }, y, cx);
+         for (int j = 1; j <= 3; ++j)
+            for (int i = 1; i <= n; ++i)
+               REQUIRE(y(i, j) == i + 2 * j);
+      }
+   }
+
+   SECTION("views and mixed containers")
+   {
+      tensor<float, 4, 6> t{};
+      allocatable<float, 1, 1> a;
+      a.allocate(6, 4);
+      a.fill(1);
+      for_each_simd([](float& u, float v) { u = v + 1; }, t, a);
+      REQUIRE(t.c(3, 5) == 2);
+
+      // every other column, unaligned first element
+      for_each_simd([](float& u) { u = -1; },
+                    a.section(triplet(2, 6), triplet(1, 4, 2)));
+      REQUIRE(a(1, 1) == 1);
+      REQUIRE(a(2, 1) == -1);
+      REQUIRE(a(6, 3) == -1);
+      REQUIRE(a(6, 4) == 1);
+
+      // strided first dimension
+      for_each_simd([](float& u) { u = 5; }, a.section(triplet(1, 6, 2), 4));
+      REQUIRE(a(5, 4) == 5);
+      REQUIRE(a(6, 4) == 1);
+
+      allocatable<float, 1, 1> b;
+      b.allocate(4, 6);
+      REQUIRE_THROWS_AS(for_each_simd([](float&, float) {}, b, a),
+                        std::invalid_argument);
+   }
+}
@@ -0,0 +1,153 @@
+#define FA_WITH_THREADS
+#include "FortranArray"
+#include "catch.hpp"
+#include <memory>
+#include <vector>
+using namespace fa;
+
+namespace {
+// counts the live objects to check construction and destruction
+struct counted
+{
+   static int live;
+   int v;
+
+   counted()
+      : v(0)
+   {
+      ++live;
+   }
+
+   counted(counted&& o) noexcept
+      : v(o.v)
+   {
+      ++live;
+   }
+
+   ~counted()
+   {
+      --live;
+   }
+};
+
+int counted::live = 0;
+}
+
+TEST_CASE("small allocatable", "[small]")
+{
+   SECTION("inline and heap storage")
+   {
+      small_allocatable<double, 16, 1, 1> j;
+      REQUIRE(!j.allocated());
+      REQUIRE(!j.is_inline());
+      REQUIRE(j.size() == 0);
+
+      j.allocate(4, bounds(0, 3));
+      REQUIRE(j.is_inline());
+      REQUIRE(j.capacity() == 16);
+      const char* self = reinterpret_cast<const char*>(&j);
+      const char* p = reinterpret_cast<const char*>(j.data());
+      REQUIRE(p >= self);
+      REQUIRE(p < self + sizeof(j));
+      REQUIRE(j.lbound(2) == 0);
+      REQUIRE(j.ubound(2) == 3);
+      for (index_t c = 0; c <= 3; ++c)
+         for (index_t r = 1; r <= 4; ++r)
+            j(r, c) = 10 * r + c;
+      REQUIRE(j.data()[1] == 20);
+      REQUIRE(j.c(3, 0) == 13);
+      REQUIRE(j.fortran_index(2, 1) == 5);
+      REQUIRE(j.section(all, 2).size(1) == 4);
+
+      j.reallocate(5, 5);
+      REQUIRE(!j.is_inline());
+      REQUIRE(j.capacity() == 25);
+      REQUIRE(j.lbound(2) == 1);
+      j.fill(2);
+      REQUIRE(j(5, 5) == 2);
+      j.deallocate();
+      REQUIRE(!j.allocated());
+   }
+
+   SECTION("moves")
+   {
+      small_allocatable<int, 8, 1> a, b;
+      a.allocate(bounds(-2, 2));
+      for (int i = -2; i <= 2; ++i)
+         a(i) = i * i;
+      b = std::move(a);
+      REQUIRE(!a.allocated());
+      REQUIRE(b.is_inline());
+      REQUIRE(b.lbound(1) == -2);
+      REQUIRE(b(2) == 4);
+
+      a.allocate(20);
+      a.fill(7);
+      const int* heap = a.data();
+      small_allocatable<int, 8, 1> c(std::move(a));
+      REQUIRE(c.data() == heap);
+      REQUIRE(!a.allocated());
+
+      swap(b, c);
+      REQUIRE(b.size() == 20);
+      REQUIRE(b.data() == heap);
+      REQUIRE(c.is_inline());
+      REQUIRE(c(-1) == 1);
+
+      // a vector of blocks keeps the elements through reallocation
+      std::vector<small_allocatable<int, 8, 1, 1>> v(3);
+      for (int k = 0; k < 3; ++k) {
+         v[k].allocate(2, 2);
+         v[k].fill(k);
+      }
+      v.resize(100);
+      for (int k = 0; k < 3; ++k)
+         REQUIRE(v[k](2, 2) == k);
+   }
+
+   SECTION("elements are constructed and destroyed")
+   {
+      {
+         small_allocatable<counted, 4, 1> a;
+         a.allocate(3);
+         REQUIRE(counted::live == 3);
+         a(2).v = 5;
+         small_allocatable<counted, 4, 1> b(std::move(a));
+         REQUIRE(counted::live == 3);
+         REQUIRE(b(2).v == 5);
+         b.reallocate(10);
+         REQUIRE(counted::live == 10);
+      }
+      REQUIRE(counted::live == 0);
+   }
+
+   SECTION("expressions")
+   {
+      small_allocatable<double, 9, 1, 1> a, b;
+      a.allocate(3, 3);
+      for (index_t i = 1; i <= 3; ++i)
+         for (index_t j = 1; j <= 3; ++j)
+            a(i, j) = i + j;
+      b = 2 * a + 1;
+      REQUIRE(b.is_inline());
+      REQUIRE(b(3, 2) == 11);
+      b -= a;
+      REQUIRE(sum(b) == sum(a) + 9);
+
+      allocatable<double, 1, 1> h;
+      h = a * b;
+      REQUIRE(h(1, 1) == 2 * 3);
+   }
+
+   SECTION("fill, sections and checked access as in allocatable")
+   {
+      small_allocatable<double, 16, 1, 1> a;
+      a.allocate(4, 4);
+      a.fill(2.0, thread_pool(2));
+      REQUIRE(sum(a) == 32);
+      a(3, 2) = 5;
+      REQUIRE(a.section(all, 2)(3) == 5);
+      a.zero(serial());
+      REQUIRE(a.c(3, 3) == 0);
+   }
+}
@@ -0,0 +1,100 @@
+#include "FortranArray"
+#include "catch.hpp"
+using namespace fa;
+
+namespace {
+struct tracked
+{
+   static int alive;
+   int value;
+   tracked()
+      : value(7)
+   {
+      ++alive;
+   }
+   ~tracked()
+   {
+      --alive;
+   }
+};
+int tracked::alive = 0;
+}
+
+TEST_CASE("structure of arrays", "[soa]")
+{
+   SECTION("fields share the shape and are separately aligned")
+   {
+      soa_allocatable<std::tuple<double, float, char>, 1, 0> p;
+      REQUIRE(!p.allocated());
+      p.allocate(5, bounds(-1, 2));
+      REQUIRE(p.allocated());
+      REQUIRE(p.size() == 20);
+      REQUIRE(p.lbound(2) == -1);
+      REQUIRE(p.ubound(2) == 2);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(p.data<0>()) % 64 == 0);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(p.data<1>()) % 64 == 0);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(p.data<2>()) % 64 == 0);
+
+      for (int j = -1; j <= 2; ++j)
+         for (int i = 1; i <= 5; ++i) {
+            p.get<0>(i, j) = 10 * i + j;
+            p.get<1>(i, j) = i;
+            p.get<2>(i, j) = 'a' + i;
+         }
+      REQUIRE(&p.get<0>(1, -1) == p.data<0>());
+      REQUIRE(&p.get<1>(5, 2) == p.data<1>() + 19);
+      REQUIRE(&p.c<1>(3, 4) == p.data<1>() + 19);
+      REQUIRE(p.c<0>(1, 2) == 3 * 10 + 0);
+
+      // tuple of references to one element
+      auto e = p(2, 1);
+      REQUIRE(std::get<0>(e) == 21);
+      std::get<1>(e) = -1;
+      REQUIRE(p.get<1>(2, 1) == -1);
+      double x;
+      char ch;
+      std::tie(x, std::ignore, ch) = p(4, 0);
+      REQUIRE(x == 40);
+      REQUIRE(ch == 'e');
+   }
+
+   SECTION("field views")
+   {
+      soa_allocatable<std::tuple<double, double>, 1> p;
+      p.allocate(100);
+      for_each_simd([](double& x, double& v) { x = 1, v = 2; }, p.field<0>(),
+                    p.field<1>());
+      for_each_simd([](double& x, double v) { x += 0.5 * v; }, p.field<0>(),
+                    p.field<1>());
+      REQUIRE(p.get<0>(100) == 2);
+      REQUIRE(p.field<0>().section(triplet(2, 10))(1) == 2);
+
+      const auto& cp = p;
+      double total = 0;
+      for (auto s : spans(cp.field<1>()))
+         for (double v : s)
+            total += v;
+      REQUIRE(total == 200);
+   }
+
+   SECTION("move, deallocate and non-trivial fields")
+   {
+      {
+         soa_allocatable<std::tuple<tracked, int>, 1, 1> p;
+         p.allocate(3, 4);
+         REQUIRE(tracked::alive == 12);
+         REQUIRE(p.get<0>(3, 4).value == 7);
+         soa_allocatable<std::tuple<tracked, int>, 1, 1> q(std::move(p));
+         REQUIRE(!p.allocated());
+         REQUIRE(q.size() == 12);
+         p.allocate(2, 2);
+         REQUIRE(tracked::alive == 16);
+         q = std::move(p);
+         REQUIRE(tracked::alive == 4);
+         q.deallocate();
+         REQUIRE(tracked::alive == 0);
+         q.allocate(1, 1);
+      }
+      REQUIRE(tracked::alive == 0);
+   }
+}
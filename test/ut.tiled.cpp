@@ -0,0 +1,82 @@
+#define FA_WITH_THREADS
+#include "FortranArray"
+#include "catch.hpp"
+#include <atomic>
+using namespace fa;
+
+TEST_CASE("tiled allocatable", "[tiled]")
+{
+   SECTION("2-d 8x8 tiles with padding")
+   {
+      tiled_allocatable<int, 8, 1, 1> a;
+      a.allocate(10, bounds(-2, 17));
+      REQUIRE(a.size() == 200);
+      // 2 x 3 tiles of 64 elements and a cache line
+      REQUIRE(a.storage_size() == 6 * (64 + 16));
+      REQUIRE(a.ubound(2) == 17);
+      REQUIRE(a.storage_index(1, -2) == 0);
+      REQUIRE(a.storage_index(8, -2) == 7);
+      REQUIRE(a.storage_index(1, -1) == 8);
+      REQUIRE(a.storage_index(9, -2) == 80);
+      REQUIRE(a.storage_index(1, 6) == 160);
+
+      // every element has its own slot
+      a.fill(-1);
+      for (int j = -2; j <= 17; ++j)
+         for (int i = 1; i <= 10; ++i) {
+            REQUIRE(a(i, j) == -1);
+            a(i, j) = 100 * i + j;
+         }
+      for (int j = -2; j <= 17; ++j)
+         for (int i = 1; i <= 10; ++i)
+            REQUIRE(a(i, j) == 100 * i + j);
+   }
+
+   SECTION("tile views cover the array once")
+   {
+      tiled_allocatable<double, 4, 1, 1, 1> u;
+      u.allocate(6, 5, 9);
+      u.fill(0);
+      int tiles = 0;
+      u.for_each_tile([&](view<double, 3> v) {
+         ++tiles;
+         REQUIRE(v.size(1) <= 4);
+         REQUIRE((v.lbound(1) - 1) % 4 == 0);
+         for (index_t k = v.lbound(3); k <= v.ubound(3); ++k)
+            for (index_t j = v.lbound(2); j <= v.ubound(2); ++j)
+               for (index_t i = v.lbound(1); i <= v.ubound(1); ++i) {
+                  REQUIRE(&v(i, j, k) == &u(i, j, k));
+                  v(i, j, k) += 1;
+               }
+      });
+      REQUIRE(tiles == 2 * 2 * 3);
+      for (int k = 1; k <= 9; ++k)
+         for (int j = 1; j <= 5; ++j)
+            for (int i = 1; i <= 6; ++i)
+               REQUIRE(u(i, j, k) == 1);
+   }
+
+   SECTION("threaded tile loop and move")
+   {
+      tiled_allocatable<float, 8, 0, 0> a;
+      a.allocate(100, 70);
+      std::atomic<long> count(0);
+      thread_pool pool(4);
+      a.for_each_tile(
+         [&](view<float, 2> v) {
+            count += v.size();
+            for (auto s : spans(v))
+               for (float& x : s)
+                  x = 2;
+         },
+         pool);
+      REQUIRE(count == 7000);
+      REQUIRE(a(99, 69) == 2);
+
+      tiled_allocatable<float, 8, 0, 0> b(std::move(a));
+      REQUIRE(!a.allocated());
+      REQUIRE(b(0, 0) == 2);
+      b.deallocate();
+      REQUIRE(b.size() == 0);
+   }
+}
@@ -0,0 +1,95 @@
+#define FA_WITH_THREADS
+#include "FortranArray"
+#include "catch.hpp"
+using namespace fa;
+
+TEST_CASE("transpose and permute", "[transpose]")
+{
+   SECTION("2-d transpose across tile edges")
+   {
+      allocatable<int, 1, 1> a, b;
+      a.allocate(70, 45);
+      b.allocate(45, 70);
+      for (int j = 1; j <= 45; ++j) {
+         for (int i = 1; i <= 70; ++i) {
+            a(i, j) = 1000 * i + j;
+         }
+      }
+      thread_pool pool(3);
+      transpose(b, a, pool);
+      for (int j = 1; j <= 70; ++j) {
+         for (int i = 1; i <= 45; ++i) {
+            REQUIRE(b(i, j) == a(j, i));
+         }
+      }
+      REQUIRE_THROWS_AS(transpose(a, a), std::invalid_argument);
+   }
+
+   SECTION("layout conversion between dimension and tensor")
+   {
+      dimension<double, 5, 6, 7> d;
+      tensor<double, 5, 6, 7> t;
+      dimension<double, 5, 6, 7> e;
+      for (int k = 1; k <= 7; ++k) {
+         for (int j = 1; j <= 6; ++j) {
+            for (int i = 1; i <= 5; ++i) {
+               d(i, j, k) = 100 * i + 10 * j + k;
+            }
+         }
+      }
+      convert_layout(t, d);
+      for (int i = 0; i < 5; ++i) {
+         for (int j = 0; j < 6; ++j) {
+            for (int k = 0; k < 7; ++k) {
+               REQUIRE(t[i][j][k] == d(i + 1, j + 1, k + 1));
+            }
+         }
+      }
+      convert_layout(e, t);
+      for (int n = 0; n < 5 * 6 * 7; ++n) {
+         REQUIRE(e.data()[n] == d.data()[n]);
+      }
+   }
+
+   SECTION("general permutation")
+   {
+      allocatable<int, 1, 1, 1> a, b;
+      a.allocate(3, 40, 5);
+      b.allocate(40, 5, 3);
+      for (int k = 1; k <= 5; ++k) {
+         for (int j = 1; j <= 40; ++j) {
+            for (int i = 1; i <= 3; ++i) {
+               a(i, j, k) = 10000 * i + 10 * j + k;
+            }
+         }
+      }
+      permute(b, a, {{2, 3, 1}});
+      for (int k = 1; k <= 5; ++k) {
+         for (int j = 1; j <= 40; ++j) {
+            for (int i = 1; i <= 3; ++i) {
+               REQUIRE(b(j, k, i) == a(i, j, k));
+            }
+         }
+      }
+      REQUIRE_THROWS_AS(permute(b, a, {{2, 2, 1}}), std::invalid_argument);
+   }
+
+   SECTION("in-place square transpose")
+   {
+      for (int n : {1, 31, 32, 33, 100}) {
+         allocatable<int, 1, 1> a;
+         a.allocate(n, n);
+         for (int j = 1; j <= n; ++j) {
+            for (int i = 1; i <= n; ++i) {
+               a(i, j) = 1000 * i + j;
+            }
+         }
+         transpose_in_place(a, thread_pool(2));
+         for (int j = 1; j <= n; ++j) {
+            for (int i = 1; i <= n; ++i) {
+               REQUIRE(a(i, j) == 1000 * j + i);
+            }
+         }
+      }
+   }
+}
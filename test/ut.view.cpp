@@ -0,0 +1,130 @@
+#include "FortranArray"
+#include "catch.hpp"
+using namespace fa;
+
+TEST_CASE("views of whole arrays", "[view]")
+{
+   SECTION("allocatable with runtime bounds")
+   {
+      allocatable<int, 1, 1, 1> ff;
+      ff.allocate(4, bounds(-1, 1), 2);
+      for (int i = 0; i < ff.size(); ++i) {
+         ff.data()[i] = i;
+      }
+
+      view<int, 3> v(ff);
+      REQUIRE(v.size() == 24);
+      REQUIRE(v.contiguous());
+      REQUIRE(v.lbound(2) == -1);
+      REQUIRE(v.ubound(2) == 1);
+
+      for (int a = 1; a <= 2; ++a)
+         for (int b = -1; b <= 1; ++b)
+            for (int c = 1; c <= 4; ++c) {
+               REQUIRE(&v(c, b, a) == &ff(c, b, a));
+               REQUIRE(&v.c(a - 1, b + 1, c - 1) == &ff.c(a - 1, b + 1, c - 1));
+            }
+
+      const allocatable<int, 1, 1, 1>& cf = ff;
+      view<const int, 3> cv(cf);
+      view<const int, 3> cv2 = v;
+      REQUIRE(&cv(4, 1, 2) == &ff(4, 1, 2));
+      REQUIRE(&cv2(4, 1, 2) == &ff(4, 1, 2));
+   }
+
+   SECTION("dimension and tensor")
+   {
+      dimension<int, r(0, 3), 5> ff;
+      tensor<int, r(0, 1), r(5, 7)> cc;
+      view<int, 2> vf(ff);
+      view<int, 2> vc(cc);
+      REQUIRE(vf.lbound(1) == 0);
+      REQUIRE(vf.lbound(2) == 1);
+      REQUIRE(vc.lbound(1) == 5);
+      REQUIRE(vc.lbound(2) == 0);
+
+      for (int a = 0; a <= 1; ++a)
+         for (int b = 5; b <= 7; ++b) {
+            REQUIRE(&vc(b, a) == &cc(b, a));
+            REQUIRE(&vc.c(a, b - 5) == &cc[a][b - 5]);
+         }
+      for (int a = 1; a <= 5; ++a)
+         for (int b = 0; b <= 3; ++b) {
+            REQUIRE(&vf(b, a) == &ff(b, a));
+         }
+   }
+}
+
+TEST_CASE("array sections", "[view]")
+{
+   allocatable<int, 1, 1, 1> a;
+   const int n = 6;
+   a.allocate(n, n + 1, n + 2);
+   for (int i = 0; i < a.size(); ++i) {
+      a.data()[i] = i;
+   }
+
+   SECTION("a(2:n-1, :, k)")
+   {
+      const int k = 3;
+      auto p = a.section(triplet(2, n - 1), all, k);
+      REQUIRE(p.size(1) == n - 2);
+      REQUIRE(p.size(2) == n + 1);
+      REQUIRE(p.lbound(1) == 1);
+      REQUIRE(p.lbound(2) == 1);
+      REQUIRE_FALSE(p.contiguous());
+      for (int j = 1; j <= n + 1; ++j)
+         for (int i = 1; i <= n - 2; ++i) {
+            REQUIRE(&p(i, j) == &a(i + 1, j, k));
+         }
+      REQUIRE(&p.c(1, 0) == &a(2, 2, k));
+   }
+
+   SECTION("strided, reversed and nested sections")
+   {
+      auto p = a.section(triplet(1, n, 2), 2, triplet(n + 2, 1, -3));
+      REQUIRE(p.size(1) == 3);
+      REQUIRE(p.size(2) == 3);
+      for (int j = 1; j <= 3; ++j)
+         for (int i = 1; i <= 3; ++i) {
+            REQUIRE(&p(i, j) == &a(2 * i - 1, 2, n + 5 - 3 * j));
+         }
+
+      auto q = p.section(2, all);
+      REQUIRE(q.size() == 3);
+      for (int j = 1; j <= 3; ++j) {
+         REQUIRE(&q(j) == &a(3, 2, n + 5 - 3 * j));
+      }
+
+      auto s = p.section(bounds(2, 3), r(1, 2)).rebase(0, -1);
+      REQUIRE(s.lbound(1) == 0);
+      REQUIRE(s.lbound(2) == -1);
+      REQUIRE(&s(0, -1) == &p(2, 1));
+      REQUIRE(&s(1, 0) == &p(3, 2));
+   }
+
+   SECTION("empty section")
+   {
+      auto p = a.section(triplet(3, 2), all, all);
+      REQUIRE(p.size() == 0);
+   }
+
+   SECTION("zero step")
+   {
+      REQUIRE_THROWS_AS(a.section(triplet(1, 5, 0), all, all),
+                        std::invalid_argument);
+   }
+
+   SECTION("sections of static arrays")
+   {
+      dimension<double, 4, 5> d;
+      d.zero();
+      d.section(triplet(2, 3), all)(1, 5) = 1;
+      REQUIRE(d(2, 5) == 1);
+
+      const tensor<double, 4, 5>& t = d.as<tensor<double, 4, 5>>();
+      view<const double, 1> row = t.section(all, 3);
+      REQUIRE(row.size() == 5);
+      REQUIRE(&row(1) == &t[3][0]);
+   }
+}